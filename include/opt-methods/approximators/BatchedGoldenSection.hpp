@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <vector>
+
+#include "opt-methods/solvers/Approximator.hpp"
+
+/**
+ * function evaluating W points at once
+ */
+template<typename F, typename P, typename V, std::size_t W>
+concept BatchFunction = requires(F& f, std::array<P, W> const& xs) {
+	{ f(xs) } -> std::same_as<std::array<V, W>>;
+};
+
+/**
+ * golden section over many independent intervals at once
+ * W lanes are advanced in lockstep, lane state is kept in structure-of-arrays form,
+ * lanes are updated with bitwise selects instead of branches, so the update does not mispredict on f1 < f2;
+ * compiler vectorizes it when target compares 64-bit integers in vectors (SSE4.1, AVX2), on plain x86-64 it stays scalar
+ * converged lane is refilled with next pending interval; every step each active lane needs exactly one evaluation
+ */
+template<std::floating_point P, typename V, std::size_t W = 8>
+class BatchedGoldenSection
+{
+private:
+	using Bits = std::conditional_t<sizeof(P) == 8, std::uint64_t, std::uint32_t>;
+
+	// lane phases, as wide as lane values so that masks of both vectorize together
+	static constexpr Bits NeedF1 = 0, NeedF2 = 1, Running = 2, Idle = 3;
+
+	struct Lanes
+	{
+		alignas(64) std::array<P, W> a, b, x1, x2, pt;
+		alignas(64) std::array<V, W> f1, f2, fpt;
+		alignas(64) std::array<Bits, W> phase;
+		std::array<std::size_t, W> task;
+	};
+
+	/// c ? x : y without branch
+	template<typename T>
+	static T Select(bool c, T x, T y) noexcept
+	{
+		using U = std::conditional_t<sizeof(T) == 8, std::uint64_t, std::uint32_t>;
+		U mask = -U(c);
+		return std::bit_cast<T>(U((std::bit_cast<U>(x) & mask) | (std::bit_cast<U>(y) & ~mask)));
+	}
+
+	/// formula of libstdc++ std::lerp for t in (0, 1) with selects, so lanes match GoldenSectionApproximator bit for bit there
+	static P Lerp(P a, P b, P t) noexcept
+	{
+		P straddle = t * b + (1 - t) * a;
+		P x = a + t * (b - a);
+		bool up = b > a;
+		bool inside = (up & (b > x)) | (!up & (b < x));
+		bool crosses = ((a <= 0) & (b >= 0)) | ((a >= 0) & (b <= 0));
+		return Select(crosses, straddle, Select(inside, x, b));
+	}
+
+public:
+	static char const* name() noexcept { return "batched golden section"; }
+
+	static constexpr P tau = std::numbers::phi_v<P> - 1;
+
+	P epsilon;
+
+	BatchedGoldenSection(P epsilon)
+	: epsilon(epsilon)
+	{}
+
+	/**
+	 * @param func -- either BatchFunction on W points or plain function of one point
+	 * @return final bounds for each interval, same as GoldenSectionApproximator would yield last
+	 * (unless compiler contracts lerp into fused multiply-add differently in the two)
+	 */
+	template<typename F>
+		requires BatchFunction<F, P, V, W> || Function<F, P, V>
+	std::vector<PointRegion<P>> operator()(F func, std::span<PointRegion<P> const> regions) const
+	{
+		std::vector<PointRegion<P>> res(regions.size(), PointRegion<P>{P(0), P(0)});
+		std::size_t next = 0, active = 0;
+		Lanes s{};
+
+		auto load = [&](std::size_t l) {
+			s.phase[l] = Idle;
+			while (next < regions.size())
+			{
+				P a = regions[next].p - regions[next].r, b = regions[next].p + regions[next].r;
+				if (b - a >= epsilon)
+				{
+					s.a[l] = a, s.b[l] = b;
+					s.x1[l] = std::lerp(a, b, 1 - tau), s.x2[l] = std::lerp(a, b, tau);
+					s.phase[l] = NeedF1;
+					s.task[l] = next++;
+					active++;
+					return;
+				}
+				res[next++] = {a, b, bound_tag};
+			}
+		};
+		for (std::size_t l = 0; l < W; l++)
+			load(l);
+
+		while (active != 0)
+		{
+			// choose evaluation point of each lane
+			for (std::size_t l = 0; l < W; l++)
+			{
+				Bits phase = s.phase[l];
+				bool left = s.f1[l] < s.f2[l];
+				P running = Lerp(Select(left, s.a[l], s.x1[l]), Select(left, s.x2[l], s.b[l]), Select(left, 1 - tau, tau));
+				s.pt[l] = Select(phase == NeedF1, s.x1[l], Select(phase == NeedF2, s.x2[l], running));
+			}
+
+			if constexpr (BatchFunction<F, P, V, W>)
+				s.fpt = func(s.pt);
+			else
+				for (std::size_t l = 0; l < W; l++)
+					if (s.phase[l] != Idle)
+						s.fpt[l] = func(s.pt[l]);
+
+			Bits done = 0;
+			for (std::size_t l = 0; l < W; l++)
+			{
+				Bits phase = s.phase[l];
+				bool running = phase == Running, left = s.f1[l] < s.f2[l];
+				bool toLeft = running & left, toRight = running & !left;
+				P a = s.a[l], b = s.b[l], x1 = s.x1[l], x2 = s.x2[l], pt = s.pt[l];
+				V f1 = s.f1[l], f2 = s.f2[l], fp = s.fpt[l];
+				s.a[l]  = Select(toRight, x1, a);
+				s.b[l]  = Select(toLeft, x2, b);
+				s.x1[l] = Select(toLeft, pt, Select(toRight, x2, x1));
+				s.x2[l] = Select(toLeft, x1, Select(toRight, pt, x2));
+				s.f1[l] = Select(toLeft | (phase == NeedF1), fp, Select(toRight, f2, f1));
+				s.f2[l] = Select(toLeft, f1, Select(toRight | (phase == NeedF2), fp, f2));
+				s.phase[l] = phase + (phase < Running);
+				done |= running & (s.b[l] - s.a[l] < epsilon);
+			}
+			if (done == 0)
+				continue;
+
+			for (std::size_t l = 0; l < W; l++)
+				if (s.phase[l] == Running && s.b[l] - s.a[l] < epsilon)
+				{
+					res[s.task[l]] = {s.a[l], s.b[l], bound_tag};
+					active--;
+					load(l);
+				}
+		}
+		return res;
+	}
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <optional>
+
+#include "opt-methods/solvers/BaseApproximator.hpp"
+
+/**
+ * Swann bracketing before any one-dimensional method:
+ * region is read as start point and initial step (scaled by initialStep),
+ * step grows in expand (golden ratio by default) times until function increases, then onedim runs on found bracket
+ */
+template<std::floating_point From, typename To, Approximator<From, To> OneDimApprox>
+class BracketingApproximator : public BaseApproximator<From, To, BracketingApproximator<From, To, OneDimApprox>>
+{
+	using BaseT = BaseApproximator<From, To, BracketingApproximator>;
+
+public:
+	using P = From;
+	using V = To;
+
+	using IterationData = typename OneDimApprox::IterationData;
+
+	static char const* name() noexcept { return "bracketing"; }
+
+	OneDimApprox onedim;
+	P initialStep, expand;
+	std::size_t maxExpansions;
+
+	BracketingApproximator(OneDimApprox onedim, P initialStep = 1, P expand = std::numbers::phi_v<P>, std::size_t maxExpansions = 60)
+	: onedim(std::move(onedim))
+	, initialStep(initialStep)
+	, expand(expand)
+	, maxExpansions(maxExpansions)
+	{}
+
+	static void draw_impl(BoundsWithValues<P, V> r, IterationData const& data, QtCharts::QChart &chart)
+	{
+		if constexpr (HasDrawImpl<OneDimApprox, P, V>)
+			OneDimApprox::draw_impl(r, data, chart);
+	}
+
+	/**
+	 * @return bounds containing local minimum, if function stops decreasing within maxExpansions
+	 */
+	template<Function<P, V> F>
+	std::optional<PointRegion<P>> bracket(F& func, P x, P h) const
+	{
+		if (h == 0)
+			h = initialStep;
+		V fx = func(x), fr = func(x + h);
+		if (fr >= fx)
+		{
+			V fl = func(x - h);
+			if (fl >= fx)
+				return PointRegion<P>{x - h, x + h, bound_tag};
+			// go left
+			h = -h;
+			std::swap(fl, fr);
+		}
+		P prev = x;
+		x += h;
+		fx = fr;
+		for (std::size_t i = 0; i < maxExpansions; i++)
+		{
+			h *= expand;
+			P next = x + h;
+			V fn = func(next);
+			if (fn >= fx)
+				return PointRegion<P>{std::min(prev, next), std::max(prev, next), bound_tag};
+			prev = x, x = next, fx = fn;
+		}
+		return {};
+	}
+
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	{
+		BEGIN_APPROX_COROUTINE(data);
+
+		auto found = bracket(func, r.p, initialStep * r.r);
+		if (!found.has_value())
+		{
+			// function is unbounded or monotone on checked range
+			co_yield r;
+			co_return;
+		}
+
+		auto gen = onedim(std::move(func), *found);
+		bool any = false;
+		while (gen.next())
+		{
+			any = true;
+			*data = static_cast<IterationData const&>(gen.getIterationData());
+			co_yield gen.getValue();
+		}
+		if (!any)
+			co_yield *found; // bracket is already tight enough
+	}
+};
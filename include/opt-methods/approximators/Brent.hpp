@@ -3,6 +3,7 @@
 #include <numbers>
 #include <cassert>
 #include <optional>
+#include <tuple>
 
 #include <QtCharts/QLineSeries>
 
@@ -44,26 +45,46 @@ public:
 	}
 
 	template<Function<P, V> F>
-	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	class Stepper
 	{
-		using std::abs;
-		using std::lerp;
-		using std::copysign;
-
-		BEGIN_APPROX_COROUTINE(data);
-
-		auto [a, fa, b, fb] = this->countBwV(func, r);
+	private:
+		BrentApproximator const* approx;
+		F func;
+		PointRegion<P> r;
+		P a, b;
+		V fa, fb;
 		///   a      c
-		auto x = lerp(a, b, 1 - tau), premin = x, last_premin = x;
+		P x, premin, last_premin;
 		///  x                        w            v
-		auto fx = func(x), fpm = fx, flpm = fx;
-		auto cur_step = b - a, last_step = cur_step;
+		V fx, fpm, flpm;
+		P cur_step, last_step;
 		///   d                   e
 
-		while (true)
+	public:
+		Stepper(BrentApproximator const& approx, F func, PointRegion<P> r)
+		: approx(&approx)
+		, func(std::move(func))
+		, r(std::move(r))
+		{}
+
+		void start()
 		{
-			auto epsilon = this->epsilon * (abs(x) + P(0.1));
-			if (abs(x - (a + b) / 2) + (b - a) / 2 <= 2 * epsilon) break;
+			using std::lerp;
+
+			std::tie(a, fa, b, fb) = approx->countBwV(func, r);
+			x = premin = last_premin = lerp(a, b, 1 - tau);
+			fx = fpm = flpm = func(x);
+			cur_step = last_step = b - a;
+		}
+
+		bool step(IterationData& data)
+		{
+			using std::abs;
+			using std::lerp;
+			using std::copysign;
+
+			auto epsilon = approx->epsilon * (abs(x) + P(0.1));
+			if (abs(x - (a + b) / 2) + (b - a) / 2 <= 2 * epsilon) return false;
 
 			auto step = last_step;
 			///   g
@@ -75,7 +96,7 @@ public:
 
 			P u;
 			{
-				data->useParabola = false;
+				data.useParabola = false;
 
 				std::optional<P> optu;
 				if (all_uneq(x, premin, last_premin) && all_uneq(fx, fpm, flpm))
@@ -90,8 +111,8 @@ public:
 							u_cand = x - copysign(epsilon, x - (a + b) / 2); // don't stick
 						optu = u_cand;
 
-						data->useParabola = true;
-						data->parabola    = {{}, a0, a1, a2, x, premin, last_premin, {P(0), V(0)}};
+						data.useParabola = true;
+						data.parabola    = {{}, a0, a1, a2, x, premin, last_premin, {P(0), V(0)}};
 					}
 				}
 
@@ -118,7 +139,7 @@ public:
 			cur_step = abs(u - x);
 
 			auto fu = func(u);
-			data->parabola.bar = {u, fu};
+			data.parabola.bar = {u, fu};
 			if (fu <= fx)
 			{
 				if (u >= x)
@@ -145,8 +166,34 @@ public:
 					flpm        = fu;
 				}
 			}
+			return true;
+		}
 
-			co_yield {a, b, bound_tag};
+		PointRegion<P> region() const { return {a, b, bound_tag}; }
+
+		template<typename Archive>
+		void serialize(Archive& ar)
+		{
+			ar(a, b, fa, fb, x, premin, last_premin, fx, fpm, flpm, cur_step, last_step);
 		}
+	};
+
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	{
+		return impl::RunStepper<P, V, IterationData>(Stepper<F>(*this, std::move(func), std::move(r)));
+	}
+
+	template<Function<P, V> F>
+	std::optional<PointRegion<P>> minimize(F func, PointRegion<P> r) const
+	{
+		return impl::MinimizeStepper<P, IterationData>(Stepper<F>(*this, std::move(func), std::move(r)));
+	}
+
+	/// operator() with checkpoints, resumes from snapshot if given, yields nothing if snapshot does not match
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> resumable(F func, PointRegion<P> r, util::Checkpointing checkpoints, util::Snapshot const* from) const
+	{
+		return impl::RunStepper<P, V, IterationData>(Stepper<F>(*this, std::move(func), std::move(r)), std::move(checkpoints), from);
 	}
 };
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cassert>
+#include <optional>
+
+#include "./Brent.hpp"
+#include "opt-methods/solvers/function/ErasedFunction.hpp"
+
+/**
+ * brent method with derivatives: secant steps on derivatives of two best points,
+ * derivative sign chooses which part of bounds to bisect
+ * plain brent is used if function has no grad()
+ */
+template<std::floating_point From, typename To> requires std::is_convertible_v<From, To>
+class DBrentApproximator : public BaseApproximator<From, To, DBrentApproximator<From, To>>
+{
+	using BaseT = BaseApproximator<From, To, DBrentApproximator>;
+
+private:
+public:
+	using P = From;
+	using V = To;
+
+	using IterationData = typename BrentApproximator<P, V>::IterationData;
+
+	static char const* name() noexcept { return "dbrent"; }
+
+	P epsilon;
+	BrentApproximator<P, V> plain;
+
+	DBrentApproximator(P epsilon) : epsilon(epsilon), plain(epsilon) {}
+
+	static void draw_impl(BoundsWithValues<P, V> r, IterationData const& data, QtCharts::QChart &chart)
+	{
+		BrentApproximator<P, V>::draw_impl(r, data, chart);
+	}
+
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	{
+		if constexpr (HasGrad<F>)
+		{
+			if constexpr (IsErasedFunction<F>::value)
+			{
+				// erased function tells about gradient only at runtime
+				try
+				{
+					(void)func.grad();
+				}
+				catch (bad_function_call const&)
+				{
+					return plain(std::move(func), r);
+				}
+			}
+			return withDerivative(std::move(func), r);
+		}
+		else
+			return plain(std::move(func), r);
+	}
+
+private:
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> withDerivative(F func, PointRegion<P> r) const
+	{
+		using std::abs;
+		using std::copysign;
+
+		BEGIN_APPROX_COROUTINE(data);
+
+		auto deriv = func.grad();
+
+		P a = r.p - r.r, b = r.p + r.r;
+		///  x                        w            v
+		auto x = (a + b) / 2, premin = x, last_premin = x;
+		auto fx = func(x), fpm = fx, flpm = fx;
+		P dx = deriv(x), dpm = dx, dlpm = dx;
+		P cur_step = 0, last_step = 0;
+		///   d             e
+
+		data->useParabola = false;
+
+		while (true)
+		{
+			auto epsilon = this->epsilon * (abs(x) + P(0.1));
+			if (abs(x - (a + b) / 2) + (b - a) / 2 <= 2 * epsilon) break;
+
+			// bisect part where derivative points to
+			auto bisect = [&]() {
+				last_step = dx >= 0 ? a - x : b - x;
+				return last_step / 2;
+			};
+
+			P step;
+			if (abs(last_step) > epsilon)
+			{
+				auto secant = [&](P other, P dother) -> std::optional<P> {
+					if (dother == dx)
+						return {};
+					P s = (other - x) * dx / (dx - dother);
+					if ((a - (x + s)) * ((x + s) - b) > 0 && dx * s <= 0)
+						return s;
+					return {};
+				};
+				auto s1 = secant(premin, dpm), s2 = secant(last_premin, dlpm);
+				auto prev = last_step;
+				last_step = cur_step;
+				if (s1.has_value() || s2.has_value())
+				{
+					if (s1.has_value() && s2.has_value())
+						step = abs(*s1) < abs(*s2) ? *s1 : *s2;
+					else
+						step = s1.has_value() ? *s1 : *s2;
+					if (abs(step) <= abs(prev / 2))
+					{
+						if (x + step - a < 2 * epsilon || b - (x + step) < 2 * epsilon)
+							step = copysign(epsilon, (a + b) / 2 - x); // don't stick
+					}
+					else
+						step = bisect();
+				}
+				else
+					step = bisect();
+			}
+			else
+				step = bisect();
+
+			P u = x + (abs(step) >= epsilon ? step : copysign(epsilon, step));
+			cur_step = step;
+			auto fu = func(u);
+			data->parabola.bar = {u, fu};
+			if (abs(step) < epsilon && fu > fx)
+			{
+				// minimal step does not decrease function, x is within epsilon of minimum
+				co_yield {x, epsilon};
+				break;
+			}
+			P du = deriv(u);
+
+			if (fu <= fx)
+			{
+				if (u >= x)
+					a = x;
+				else
+					b = x;
+				last_premin = premin, premin = x, x = u;
+				flpm = fpm, fpm = fx, fx = fu;
+				dlpm = dpm, dpm = dx, dx = du;
+			}
+			else
+			{
+				if (u < x)
+					a = u;
+				else
+					b = u;
+				if (fu <= fpm || premin == x)
+				{
+					last_premin = premin, premin = u;
+					flpm = fpm, fpm = fu;
+					dlpm = dpm, dpm = du;
+				}
+				else if (fu < flpm || last_premin == x || last_premin == premin)
+				{
+					last_premin = u;
+					flpm = fu;
+					dlpm = du;
+				}
+			}
+
+			co_yield {a, b, bound_tag};
+		}
+	}
+};
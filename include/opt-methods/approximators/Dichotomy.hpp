@@ -32,8 +32,11 @@ public:
 			auto x = r.p;
 			auto nl = x - epsilon / 2;
 			auto nr = x + epsilon / 2;
-			auto lv = func(nl);
-			auto rv = func(nr);
+			// both evaluations are in flight when function is asynchronous
+			auto lEval = Evaluate<P, V>(func, nl);
+			auto rEval = Evaluate<P, V>(func, nr);
+			auto lv = co_await std::move(lEval);
+			auto rv = co_await std::move(rEval);
 			if (lv < rv)
 				co_yield r = {r.p - r.r, nr, bound_tag};
 			else
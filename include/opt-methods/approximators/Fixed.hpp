@@ -0,0 +1,173 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+#include "opt-methods/solvers/BaseApproximator.hpp"
+
+namespace impl
+{
+	/**
+	 * one step of golden section like method: drops part of bounds and evaluates one new point
+	 */
+	template<typename P, typename V, typename F>
+	void SectionStep(F& func, P tau, P& a, P& b, P& x1, P& x2, V& f1, V& f2)
+	{
+		if (f1 < f2)
+		{
+			b = x2;
+			x2 = x1, f2 = f1;
+			x1 = std::lerp(a, b, 1 - tau), f1 = func(x1);
+		}
+		else
+		{
+			a = x1;
+			x1 = x2, f1 = f2;
+			x2 = std::lerp(a, b, tau), f2 = func(x2);
+		}
+	}
+
+	/**
+	 * ratios used by FibonacciApproximator for given number of iterations n:
+	 * [0] is initial one, [k] is one used on iteration k
+	 */
+	template<std::floating_point P, std::size_t N, typename FibT = std::size_t>
+	consteval std::array<P, N> FibonacciRatios()
+	{
+		std::array<FibT, N + 1> fib{};
+		fib[0] = 0;
+		if constexpr (N > 0)
+			fib[1] = 1;
+		for (std::size_t i = 2; i <= N; i++)
+			fib[i] = fib[i - 1] + fib[i - 2];
+		std::array<P, N> res{};
+		for (std::size_t k = 0; k < N; k++)
+			res[k] = fib[N - k - 1] * P(1) / fib[N - k];
+		return res;
+	}
+}
+
+/**
+ * number of iterations FibonacciApproximator makes to shrink bounds in ratio times
+ */
+consteval int FibonacciIterations(double ratio)
+{
+	int n = 1;
+	unsigned long long last = 1, prelast = 0;
+	for (; last <= ratio; n++)
+		last = std::exchange(prelast, last) + last;
+	return n;
+}
+
+/**
+ * number of iterations GoldenSectionApproximator makes to shrink bounds in ratio times
+ */
+consteval int GoldenSectionIterations(double ratio)
+{
+	int n = 0;
+	for (double len = 1; len * ratio >= 1; n++)
+		len *= std::numbers::phi - 1;
+	return n;
+}
+
+/**
+ * fibonacci method with number of iterations known at compile time
+ * ratios are precomputed and minimize() is unrolled, so inner line searches need no coroutine
+ */
+template<std::floating_point From, typename To, int N>
+	requires (N >= 1)
+class FixedFibonacciApproximator : public BaseApproximator<From, To, FixedFibonacciApproximator<From, To, N>>
+{
+	using BaseT = BaseApproximator<From, To, FixedFibonacciApproximator>;
+
+private:
+	static constexpr auto ratios = impl::FibonacciRatios<From, N>();
+
+public:
+	using IterationData = typename BaseT::IterationData;
+	static char const* name() noexcept { return "fixed fibonacci"; }
+
+	using P = From;
+	using V = To;
+
+	FixedFibonacciApproximator() = default;
+
+	template<Function<P, V> F>
+	PointRegion<P> minimize(F func, PointRegion<P> r) const
+	{
+		P a = r.p - r.r, b = r.p + r.r;
+		P x1 = std::lerp(a, b, 1 - ratios[0]), x2 = std::lerp(a, b, ratios[0]);
+		V f1 = func(x1), f2 = func(x2);
+		[&]<std::size_t... K>(std::index_sequence<K...>) {
+			(impl::SectionStep(func, ratios[K + 1], a, b, x1, x2, f1, f2), ...);
+		}(std::make_index_sequence<N - 1>());
+		impl::Count(&EvaluationCounters::innerIterations, N - 1);
+		return {a, b, bound_tag};
+	}
+
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	{
+		BEGIN_APPROX_COROUTINE(data);
+
+		P a = r.p - r.r, b = r.p + r.r;
+		P x1 = std::lerp(a, b, 1 - ratios[0]), x2 = std::lerp(a, b, ratios[0]);
+		V f1 = func(x1), f2 = func(x2);
+		for (int k = 1; k < N; k++)
+		{
+			impl::SectionStep(func, ratios[k], a, b, x1, x2, f1, f2);
+			co_yield {a, b, bound_tag};
+		}
+	}
+};
+
+/**
+ * golden section with number of iterations known at compile time, see FixedFibonacciApproximator
+ */
+template<std::floating_point From, typename To, int N>
+	requires (N >= 0)
+class FixedGoldenSectionApproximator : public BaseApproximator<From, To, FixedGoldenSectionApproximator<From, To, N>>
+{
+	using BaseT = BaseApproximator<From, To, FixedGoldenSectionApproximator>;
+
+public:
+	using IterationData = typename BaseT::IterationData;
+	static char const* name() noexcept { return "fixed golden section"; }
+
+	using P = From;
+	using V = To;
+
+	static constexpr P tau = std::numbers::phi_v<P> - 1;
+
+	FixedGoldenSectionApproximator() = default;
+
+	template<Function<P, V> F>
+	PointRegion<P> minimize(F func, PointRegion<P> r) const
+	{
+		P a = r.p - r.r, b = r.p + r.r;
+		P x1 = std::lerp(a, b, 1 - tau), x2 = std::lerp(a, b, tau);
+		V f1 = func(x1), f2 = func(x2);
+		[&]<std::size_t... K>(std::index_sequence<K...>) {
+			(((void)K, impl::SectionStep(func, tau, a, b, x1, x2, f1, f2)), ...);
+		}(std::make_index_sequence<N>());
+		impl::Count(&EvaluationCounters::innerIterations, N);
+		return {a, b, bound_tag};
+	}
+
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	{
+		BEGIN_APPROX_COROUTINE(data);
+
+		P a = r.p - r.r, b = r.p + r.r;
+		P x1 = std::lerp(a, b, 1 - tau), x2 = std::lerp(a, b, tau);
+		V f1 = func(x1), f2 = func(x2);
+		for (int k = 0; k < N; k++)
+		{
+			impl::SectionStep(func, tau, a, b, x1, x2, f1, f2);
+			co_yield {a, b, bound_tag};
+		}
+	}
+};
@@ -1,7 +1,9 @@
 #pragma once
 
-#include <numbers>
 #include <cassert>
+#include <numbers>
+#include <optional>
+#include <tuple>
 
 #include "opt-methods/solvers/BaseApproximator.hpp"
 
@@ -27,19 +29,37 @@ public:
 	{}
 
 	template<Function<P, V> F>
-	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	class Stepper
 	{
-		using std::lerp;
+	private:
+		GoldenSectionApproximator const* approx;
+		F func;
+		PointRegion<P> r;
+		P a, b, x1, x2;
+		V fa, fb, f1, f2;
 
-		BEGIN_APPROX_COROUTINE(data);
+	public:
+		Stepper(GoldenSectionApproximator const& approx, F func, PointRegion<P> r)
+		: approx(&approx)
+		, func(std::move(func))
+		, r(std::move(r))
+		{}
 
-		auto [a, fa, b, fb] = this->countBwV(func, r);
+		void start()
+		{
+			using std::lerp;
 
-		P x1 = lerp(a, b, 1 - tau), x2 = lerp(a, b, tau);
-		V f1 = func(x1), f2 = func(x2);
+			std::tie(a, fa, b, fb) = approx->countBwV(func, r);
+			x1 = lerp(a, b, 1 - tau), x2 = lerp(a, b, tau);
+			f1 = func(x1), f2 = func(x2);
+		}
 
-		while (b - a >= epsilon)
+		bool step(IterationData&)
 		{
+			using std::lerp;
+
+			if (b - a < approx->epsilon)
+				return false;
 			if (f1 < f2)
 			{
 				b = x2, fb = f2;
@@ -52,8 +72,34 @@ public:
 				x1 = x2, f1 = f2;
 				x2 = lerp(a, b, tau), f2 = func(x2);
 			}
+			return true;
+		}
+
+		PointRegion<P> region() const { return {a, b, bound_tag}; }
 
-			co_yield {a, b, bound_tag};
+		template<typename Archive>
+		void serialize(Archive& ar)
+		{
+			ar(a, b, x1, x2, fa, fb, f1, f2);
 		}
+	};
+
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	{
+		return impl::RunStepper<P, V, IterationData>(Stepper<F>(*this, std::move(func), std::move(r)));
+	}
+
+	template<Function<P, V> F>
+	std::optional<PointRegion<P>> minimize(F func, PointRegion<P> r) const
+	{
+		return impl::MinimizeStepper<P, IterationData>(Stepper<F>(*this, std::move(func), std::move(r)));
+	}
+
+	/// operator() with checkpoints, resumes from snapshot if given, yields nothing if snapshot does not match
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> resumable(F func, PointRegion<P> r, util::Checkpointing checkpoints, util::Snapshot const* from) const
+	{
+		return impl::RunStepper<P, V, IterationData>(Stepper<F>(*this, std::move(func), std::move(r)), std::move(checkpoints), from);
 	}
 };
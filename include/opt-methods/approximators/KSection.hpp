@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "opt-methods/solvers/BaseApproximator.hpp"
+#include "opt-methods/util/Charting.hpp"
+#include "opt-methods/util/ThreadPool.hpp"
+
+/**
+ * places k interior points uniformly, evaluates them concurrently
+ * and shrinks bounds to neighbours of the best one (by factor 2 / (k + 1))
+ * function must be safe to call from several threads when pool is given,
+ * asynchronous function (AsyncFunction) gets all k evaluations started before the first is awaited
+ */
+template<std::floating_point From, typename To>
+class KSectionApproximator : public BaseApproximator<From, To, KSectionApproximator<From, To>>
+{
+	using BaseT = BaseApproximator<From, To, KSectionApproximator>;
+
+private:
+public:
+	using P = From;
+	using V = To;
+
+	struct IterationData : BaseT::IterationData
+	{
+		std::vector<PointAndValue<P, V>> points;
+	};
+
+	static char const* name() noexcept { return "k-section"; }
+
+	P epsilon;
+	std::size_t k;
+	std::shared_ptr<util::ThreadPool> pool;
+
+	/**
+	 * @param pool -- evaluate sequentially if null
+	 */
+	KSectionApproximator(P epsilon, std::size_t k = 5, std::shared_ptr<util::ThreadPool> pool = {})
+	: epsilon(epsilon)
+	, k(std::max<std::size_t>(k, 2))
+	, pool(std::move(pool))
+	{}
+
+	static void draw_impl(BoundsWithValues<P, V>, IterationData const& data, QtCharts::QChart &chart)
+	{
+		std::vector<QPointF> pts;
+		for (auto const& [p, v] : data.points)
+			pts.emplace_back(p, v);
+		Charting::addToChart(&chart, Charting::drawPoints(pts, "Section points"));
+	}
+
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	{
+		BEGIN_APPROX_COROUTINE(data);
+
+		P a = r.p - r.r, b = r.p + r.r;
+		std::vector<P> xs(k);
+		std::vector<V> fs(k);
+		std::vector<std::optional<Evaluation<V>>> pending(AsyncEvaluable<F, P, V> ? k : 0);
+		// for odd k best point is the middle one of next iteration, its value is reused
+		std::size_t const mid = k % 2 == 1 ? k / 2 : k;
+		bool haveMid = false;
+		P bestX{};
+
+		while (b - a >= epsilon)
+		{
+			for (std::size_t i = 0; i < k; i++)
+				xs[i] = a + (b - a) * static_cast<P>(i + 1) / static_cast<P>(k + 1);
+			if (haveMid)
+				xs[mid] = bestX;
+			if constexpr (AsyncEvaluable<F, P, V>)
+			{
+				for (std::size_t i = 0; i < k; i++)
+					if (!(haveMid && i == mid))
+						pending[i].emplace(func.evaluate(xs[i]));
+				for (std::size_t i = 0; i < k; i++)
+					if (pending[i].has_value())
+					{
+						fs[i] = co_await std::move(*pending[i]);
+						pending[i].reset();
+					}
+			}
+			else
+				util::ParallelFor(pool.get(), k, [&](std::size_t i) {
+					if (!(haveMid && i == mid))
+						fs[i] = func(xs[i]);
+				});
+
+			auto best = static_cast<std::size_t>(std::min_element(fs.begin(), fs.end()) - fs.begin());
+			data->points.clear();
+			for (std::size_t i = 0; i < k; i++)
+				data->points.emplace_back(xs[i], fs[i]);
+
+			P na = best == 0 ? a : xs[best - 1];
+			P nb = best + 1 == k ? b : xs[best + 1];
+			haveMid = mid < k && best != 0 && best + 1 != k;
+			if (haveMid)
+				bestX = xs[best], fs[mid] = fs[best];
+			a = na, b = nb;
+
+			co_yield {a, b, bound_tag};
+		}
+	}
+};
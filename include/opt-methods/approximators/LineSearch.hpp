@@ -0,0 +1,485 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+#include "opt-methods/solvers/BaseApproximator.hpp"
+#include "opt-methods/solvers/function/ErasedFunction.hpp"
+#include "opt-methods/util/Charting.hpp"
+
+/*
+ * inexact line searches for OneDimApprox slot of multidimensional methods
+ * bounds are [0, max step] along descent ray, last yielded point is accepted step
+ * nothing is yielded if ray does not descend, zero step is yielded if no acceptable step was found
+ * derivative is taken from grad() (see LineFunction), central difference is used otherwise
+ */
+
+namespace impl
+{
+	template<typename P, typename V>
+	struct LineSearchIterationData : BaseIterationData<P, V>
+	{
+		P alpha{}; // last trial step
+		V value{};
+		std::size_t evaluations = 0; // since search start
+		std::size_t derivativeEvaluations = 0;
+	};
+
+	template<typename P, typename F>
+	auto LineDerivative(F const& func)
+	{
+		auto diff = [&func](P x) -> P {
+			using std::abs;
+			using std::max;
+			using std::sqrt;
+			P h = sqrt(std::numeric_limits<P>::epsilon()) * max(P(1), abs(x));
+			return static_cast<P>(func(x + h) - func(x - h)) / (2 * h);
+		};
+		if constexpr (HasGrad<F>)
+		{
+			using G = std::decay_t<decltype(func.grad())>;
+			std::optional<G> grad;
+			try
+			{
+				grad.emplace(func.grad());
+			}
+			catch (bad_function_call const&)
+			{
+				// erased function without gradient
+			}
+			return [grad = std::move(grad), diff](P x) -> P { return grad.has_value() ? static_cast<P>((*grad)(x)) : diff(x); };
+		}
+		else
+			return diff;
+	}
+
+	/**
+	 * safeguarded step of More-Thuente search (dcstep from MINPACK-2)
+	 * x is best step, y is other end of interval, t is current trial step; updates interval and t
+	 */
+	template<typename P>
+	void MoreThuenteStep(P& stx, P& fx, P& dx, P& sty, P& fy, P& dy, P& stp, P fp, P dp, bool& brackt, P stpmin, P stpmax)
+	{
+		using std::abs;
+		using std::max;
+		using std::min;
+		using std::sqrt;
+
+		P sgnd = dp * (dx / abs(dx));
+		P stpf;
+		auto cubicGamma = [](P theta, P d1, P d2, P s, bool clamp) {
+			P v = (theta / s) * (theta / s) - (d1 / s) * (d2 / s);
+			return s * sqrt(clamp ? max(P(0), v) : v);
+		};
+
+		if (fp > fx)
+		{
+			// higher value: minimum is bracketed, cubic or quadratic step closer to stx
+			P theta = 3 * (fx - fp) / (stp - stx) + dx + dp;
+			P s = max({abs(theta), abs(dx), abs(dp)});
+			P gamma = cubicGamma(theta, dx, dp, s, false);
+			if (stp < stx)
+				gamma = -gamma;
+			P r = ((gamma - dx) + theta) / (((gamma - dx) + gamma) + dp);
+			P stpc = stx + r * (stp - stx);
+			P stpq = stx + ((dx / ((fx - fp) / (stp - stx) + dx)) / 2) * (stp - stx);
+			stpf = abs(stpc - stx) < abs(stpq - stx) ? stpc : stpc + (stpq - stpc) / 2;
+			brackt = true;
+		}
+		else if (sgnd < 0)
+		{
+			// derivatives have opposite signs: minimum is bracketed
+			P theta = 3 * (fx - fp) / (stp - stx) + dx + dp;
+			P s = max({abs(theta), abs(dx), abs(dp)});
+			P gamma = cubicGamma(theta, dx, dp, s, false);
+			if (stp > stx)
+				gamma = -gamma;
+			P r = ((gamma - dp) + theta) / (((gamma - dp) + gamma) + dx);
+			P stpc = stp + r * (stx - stp);
+			P stpq = stp + (dp / (dp - dx)) * (stx - stp);
+			stpf = abs(stpc - stp) > abs(stpq - stp) ? stpc : stpq;
+			brackt = true;
+		}
+		else if (abs(dp) < abs(dx))
+		{
+			// derivative decreases in magnitude
+			P theta = 3 * (fx - fp) / (stp - stx) + dx + dp;
+			P s = max({abs(theta), abs(dx), abs(dp)});
+			P gamma = cubicGamma(theta, dx, dp, s, true);
+			if (stp > stx)
+				gamma = -gamma;
+			P r = ((gamma - dp) + theta) / ((gamma + (dx - dp)) + gamma);
+			P stpc = r < 0 && gamma != 0 ? stp + r * (stx - stp) : stp > stx ? stpmax : stpmin;
+			P stpq = stp + (dp / (dp - dx)) * (stx - stp);
+			if (brackt)
+			{
+				stpf = abs(stpc - stp) < abs(stpq - stp) ? stpc : stpq;
+				stpf = stp > stx ? min(stp + P(0.66) * (sty - stp), stpf) : max(stp + P(0.66) * (sty - stp), stpf);
+			}
+			else
+			{
+				stpf = abs(stpc - stp) > abs(stpq - stp) ? stpc : stpq;
+				stpf = std::clamp(stpf, stpmin, stpmax);
+			}
+		}
+		else
+		{
+			// derivative does not decrease
+			if (brackt)
+			{
+				P theta = 3 * (fp - fy) / (sty - stp) + dy + dp;
+				P s = max({abs(theta), abs(dy), abs(dp)});
+				P gamma = cubicGamma(theta, dy, dp, s, false);
+				if (stp > sty)
+					gamma = -gamma;
+				P r = ((gamma - dp) + theta) / (((gamma - dp) + gamma) + dy);
+				stpf = stp + r * (sty - stp);
+			}
+			else
+				stpf = stp > stx ? stpmax : stpmin;
+		}
+
+		if (fp > fx)
+			sty = stp, fy = fp, dy = dp;
+		else
+		{
+			if (sgnd < 0)
+				sty = stx, fy = fx, dy = dx;
+			stx = stp, fx = fp, dx = dp;
+		}
+		stp = stpf;
+	}
+}
+
+/**
+ * common part of line searches: iteration data, drawing and counted evaluations
+ */
+template<std::floating_point From, typename To, typename CRTP_Child>
+class BaseLineSearch : public BaseApproximator<From, To, CRTP_Child>
+{
+public:
+	using P = From;
+	using V = To;
+	using IterationData = impl::LineSearchIterationData<P, V>;
+
+	P initialStep;
+	std::size_t maxIterations;
+
+	BaseLineSearch(P initialStep, std::size_t maxIterations)
+	: initialStep(initialStep)
+	, maxIterations(maxIterations)
+	{}
+
+	static void draw_impl(BoundsWithValues<P, V>, IterationData const& data, QtCharts::QChart &chart)
+	{
+		Charting::addToChart(&chart, Charting::drawPoints({QPointF{data.alpha, data.value}}, "Trial step"));
+	}
+
+protected:
+	/// phi(t) = func(lo + t), phi'(t) with counting
+	template<typename F>
+	static auto Counted(F const& func, P lo, IterationData* data)
+	{
+		auto deriv = impl::LineDerivative<P>(func);
+		auto phi = [&func, lo, data](P t) -> V {
+			data->evaluations++;
+			data->alpha = t;
+			return data->value = func(lo + t);
+		};
+		auto dphi = [deriv = std::move(deriv), lo, data](P t) -> P {
+			data->derivativeEvaluations++;
+			return deriv(lo + t);
+		};
+		return std::make_pair(std::move(phi), std::move(dphi));
+	}
+};
+
+/**
+ * backtracking until sufficient decrease: phi(a) <= phi(0) + c1 a phi'(0)
+ */
+template<std::floating_point From, typename To>
+class ArmijoLineSearch : public BaseLineSearch<From, To, ArmijoLineSearch<From, To>>
+{
+	using BaseT = BaseLineSearch<From, To, ArmijoLineSearch>;
+
+public:
+	using typename BaseT::P;
+	using typename BaseT::V;
+	using typename BaseT::IterationData;
+
+	static char const* name() noexcept { return "armijo"; }
+
+	P c1, shrink;
+
+	ArmijoLineSearch(P initialStep = 1, P c1 = P(1e-4), P shrink = P(0.5), std::size_t maxIterations = 60)
+	: BaseT(initialStep, maxIterations)
+	, c1(c1)
+	, shrink(shrink)
+	{}
+
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	{
+		BEGIN_APPROX_COROUTINE(data);
+
+		P lo = r.p - r.r;
+		auto [phi, dphi] = this->Counted(func, lo, data);
+		V phi0 = phi(0);
+		P d0 = dphi(0);
+		if (!(d0 < 0))
+			co_return;
+
+		P alpha = std::min(this->initialStep, 2 * r.r);
+		for (std::size_t i = 0; i < this->maxIterations; i++, alpha *= shrink)
+		{
+			if (phi(alpha) <= phi0 + c1 * alpha * d0)
+			{
+				co_yield {lo + alpha, 0};
+				co_return;
+			}
+			co_yield {lo + alpha * (1 + shrink) / 2, alpha * (1 - shrink) / 2};
+		}
+		co_yield {lo, 0};
+	}
+};
+
+/**
+ * strong wolfe conditions by More and Thuente:
+ * phi(a) <= phi(0) + c1 a phi'(0), |phi'(a)| <= c2 |phi'(0)|
+ */
+template<std::floating_point From, typename To>
+class WolfeLineSearch : public BaseLineSearch<From, To, WolfeLineSearch<From, To>>
+{
+	using BaseT = BaseLineSearch<From, To, WolfeLineSearch>;
+
+public:
+	using typename BaseT::P;
+	using typename BaseT::V;
+	using typename BaseT::IterationData;
+
+	static char const* name() noexcept { return "strong wolfe"; }
+
+	P c1, c2, xtol;
+
+	WolfeLineSearch(P initialStep = 1, P c1 = P(1e-4), P c2 = P(0.9), std::size_t maxIterations = 30, P xtol = P(1e-10))
+	: BaseT(initialStep, maxIterations)
+	, c1(c1)
+	, c2(c2)
+	, xtol(xtol)
+	{}
+
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	{
+		using std::abs;
+		using std::max;
+		using std::min;
+
+		BEGIN_APPROX_COROUTINE(data);
+
+		P lo = r.p - r.r;
+		auto [phi, dphi] = this->Counted(func, lo, data);
+		P const stpmin = 0, stpmax = 2 * r.r;
+		P finit = static_cast<P>(phi(0)), ginit = dphi(0);
+		if (!(ginit < 0) || stpmax <= 0)
+			co_return;
+
+		P stp = min(this->initialStep, stpmax);
+		P gtest = c1 * ginit;
+		P width = stpmax - stpmin, width1 = 2 * width;
+		P stx = 0, fx = finit, gx = ginit;
+		P sty = 0, fy = finit, gy = ginit;
+		P stmin = 0, stmax = stp + 4 * stp;
+		bool brackt = false, stage1 = true;
+
+		for (std::size_t i = 0; i < this->maxIterations; i++)
+		{
+			P f = static_cast<P>(phi(stp)), g = dphi(stp);
+			P ftest = finit + stp * gtest;
+			if (stage1 && f <= ftest && g >= 0)
+				stage1 = false;
+
+			bool done = (f <= ftest && abs(g) <= c2 * (-ginit))                            // converged
+			         || (brackt && (stp <= stmin || stp >= stmax))                         // rounding errors
+			         || (brackt && stmax - stmin <= xtol * stmax)                          // interval is too small
+			         || (stp == stpmax && f <= ftest && g <= gtest)                        // step is at maximum
+			         || (stp == stpmin && (f > ftest || g >= gtest));                      // step is at minimum
+			if (done)
+			{
+				co_yield {lo + stp, 0};
+				co_return;
+			}
+
+			if (stage1 && f <= fx && f > ftest)
+			{
+				// modified function, see paper
+				P fm = f - stp * gtest, fxm = fx - stx * gtest, fym = fy - sty * gtest;
+				P gm = g - gtest, gxm = gx - gtest, gym = gy - gtest;
+				impl::MoreThuenteStep(stx, fxm, gxm, sty, fym, gym, stp, fm, gm, brackt, stmin, stmax);
+				fx = fxm + stx * gtest, fy = fym + sty * gtest;
+				gx = gxm + gtest, gy = gym + gtest;
+			}
+			else
+				impl::MoreThuenteStep(stx, fx, gx, sty, fy, gy, stp, f, g, brackt, stmin, stmax);
+
+			if (brackt)
+			{
+				if (abs(sty - stx) >= P(0.66) * width1)
+					stp = stx + (sty - stx) / 2;
+				width1 = width;
+				width = abs(sty - stx);
+				stmin = min(stx, sty), stmax = max(stx, sty);
+			}
+			else
+			{
+				stmin = stp + P(1.1) * (stp - stx);
+				stmax = stp + 4 * (stp - stx);
+			}
+			stp = std::clamp(stp, stpmin, stpmax);
+			if (brackt && (stp <= stmin || stp >= stmax || stmax - stmin <= xtol * stmax))
+				stp = stx;
+
+			co_yield {lo + (stmin + stmax) / 2, (stmax - stmin) / 2};
+		}
+		co_yield {lo + stx, 0};
+	}
+};
+
+/**
+ * approximate wolfe conditions by Hager and Zhang:
+ * (2 delta - 1) phi'(0) >= phi'(a) >= sigma phi'(0), phi(a) <= phi(0) + eps |phi(0)|
+ * bracket is expanded, then shrunk with double secant steps and bisection
+ */
+template<std::floating_point From, typename To>
+class HagerZhangLineSearch : public BaseLineSearch<From, To, HagerZhangLineSearch<From, To>>
+{
+	using BaseT = BaseLineSearch<From, To, HagerZhangLineSearch>;
+
+public:
+	using typename BaseT::P;
+	using typename BaseT::V;
+	using typename BaseT::IterationData;
+
+	static char const* name() noexcept { return "hager-zhang"; }
+
+	P delta, sigma, epsilon;
+
+	HagerZhangLineSearch(P initialStep = 1, P delta = P(0.1), P sigma = P(0.9), P epsilon = P(1e-6), std::size_t maxIterations = 30)
+	: BaseT(initialStep, maxIterations)
+	, delta(delta)
+	, sigma(sigma)
+	, epsilon(epsilon)
+	{}
+
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	{
+		using std::abs;
+
+		BEGIN_APPROX_COROUTINE(data);
+
+		P lo = r.p - r.r;
+		auto [phi, dphi] = this->Counted(func, lo, data);
+		P const stpmax = 2 * r.r;
+		P const phi0 = static_cast<P>(phi(0)), d0 = dphi(0);
+		if (!(d0 < 0) || stpmax <= 0)
+			co_return;
+		P const bound = phi0 + epsilon * abs(phi0);
+
+		struct Pt
+		{
+			P t, f, d;
+		};
+		auto eval = [&](P t) { return Pt{t, static_cast<P>(phi(t)), dphi(t)}; };
+		auto accepted = [&](Pt const& c) {
+			bool wolfe = c.f <= phi0 + delta * c.t * d0 && c.d >= sigma * d0;
+			bool approx = (2 * delta - 1) * d0 >= c.d && c.d >= sigma * d0 && c.f <= bound;
+			return wolfe || approx;
+		};
+		std::optional<Pt> result;
+		auto check = [&](Pt const& c) {
+			if (!result.has_value() && accepted(c))
+				result = c;
+			return c;
+		};
+		// [a, b] with phi'(a) < 0, phi(a) <= bound, phi'(b) >= 0 -- shrink it keeping the property
+		auto bisect = [&](Pt a, Pt b) {
+			for (std::size_t i = 0; i < this->maxIterations && !result.has_value(); i++)
+			{
+				auto d = check(eval((a.t + b.t) / 2));
+				if (d.d >= 0)
+					return std::make_pair(a, d);
+				if (d.f <= bound)
+					a = d;
+				else
+					b = d;
+			}
+			return std::make_pair(a, b);
+		};
+		auto update = [&](Pt a, Pt b, Pt c) {
+			if (!(a.t < c.t && c.t < b.t))
+				return std::make_pair(a, b);
+			if (c.d >= 0)
+				return std::make_pair(a, c);
+			if (c.f <= bound)
+				return std::make_pair(c, b);
+			return bisect(a, c);
+		};
+		auto secant = [](Pt const& a, Pt const& b) { return (a.t * b.d - b.t * a.d) / (b.d - a.d); };
+
+		// bracketing
+		Pt a{0, phi0, d0}, b = a;
+		for (P c = std::min(this->initialStep, stpmax);; c = std::min(5 * c, stpmax))
+		{
+			auto pc = check(eval(c));
+			if (result.has_value())
+			{
+				co_yield {lo + result->t, 0};
+				co_return;
+			}
+			if (pc.d >= 0)
+			{
+				b = pc;
+				break;
+			}
+			if (pc.f > bound)
+			{
+				std::tie(a, b) = bisect(a, pc);
+				break;
+			}
+			a = pc;
+			if (c == stpmax)
+			{
+				// minimum is not in bounds
+				co_yield {lo + c, 0};
+				co_return;
+			}
+			co_yield {lo + c, 0};
+		}
+
+		for (std::size_t i = 0; i < this->maxIterations && !result.has_value(); i++)
+		{
+			co_yield {lo + (a.t + b.t) / 2, (b.t - a.t) / 2};
+			auto width = b.t - a.t;
+			// double secant step
+			Pt c = a;
+			if (b.d != a.d)
+				c = check(eval(secant(a, b)));
+			auto [A, B] = update(a, b, c);
+			if (!result.has_value() && (c.t == A.t || c.t == B.t))
+			{
+				auto other = c.t == B.t ? secant(b, B) : secant(a, A);
+				if (A.t < other && other < B.t)
+					std::tie(A, B) = update(A, B, check(eval(other)));
+			}
+			if (!result.has_value() && B.t - A.t > P(0.66) * width)
+				std::tie(A, B) = update(A, B, check(eval((A.t + B.t) / 2)));
+			a = A, b = B;
+			if (b.t - a.t <= std::numeric_limits<P>::epsilon() * b.t)
+				break;
+		}
+		co_yield {lo + (result.has_value() ? result->t : a.t), 0};
+	}
+};
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "opt-methods/solvers/BaseApproximator.hpp"
+#include "opt-methods/util/Charting.hpp"
+#include "opt-methods/util/ThreadPool.hpp"
+
+/**
+ * global search by Strongin for lipschitz functions, not only unimodal ones
+ * lipschitz constant is estimated from slopes of evaluated points (multiplied by reliability),
+ * k intervals with best characteristics are split per iteration, new points are evaluated concurrently
+ * function must be safe to call from several threads when pool is given
+ */
+template<std::floating_point From, typename To> requires std::is_convertible_v<To, From>
+class StronginApproximator : public BaseApproximator<From, To, StronginApproximator<From, To>>
+{
+	using BaseT = BaseApproximator<From, To, StronginApproximator>;
+
+public:
+	using P = From;
+	using V = To;
+
+	struct IterationData : BaseT::IterationData
+	{
+		std::vector<PointAndValue<P, V>> points; // evaluated on this iteration
+		PointAndValue<P, V> best;
+		P lipschitz;
+	};
+
+	static char const* name() noexcept { return "strongin"; }
+
+	P epsilon;
+	P reliability;
+	std::size_t k;
+	std::size_t maxIterations;
+	std::shared_ptr<util::ThreadPool> pool;
+
+	/**
+	 * @param pool -- evaluate sequentially if null
+	 */
+	StronginApproximator(P epsilon, P reliability = 2, std::size_t k = 1, std::shared_ptr<util::ThreadPool> pool = {}, std::size_t maxIterations = 10'000)
+	: epsilon(epsilon)
+	, reliability(reliability)
+	, k(std::max<std::size_t>(k, 1))
+	, maxIterations(maxIterations)
+	, pool(std::move(pool))
+	{}
+
+	static void draw_impl(BoundsWithValues<P, V>, IterationData const& data, QtCharts::QChart &chart)
+	{
+		std::vector<QPointF> pts;
+		for (auto const& [p, v] : data.points)
+			pts.emplace_back(p, v);
+		Charting::addToChart(&chart, Charting::drawPoints(pts, "New points"));
+		Charting::addToChart(&chart, Charting::drawPoints({QPointF(data.best.p, data.best.v)}, "Best point"));
+	}
+
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	{
+		using std::abs;
+
+		BEGIN_APPROX_COROUTINE(data);
+
+		struct Interval
+		{
+			P l, r;
+			P fl, fr;
+			P characteristic;
+
+			bool operator<(Interval const& o) const { return characteristic < o.characteristic; }
+		};
+
+		bool haveBest = false;
+		auto evaluate = [&](std::vector<P> const& xs) {
+			std::vector<P> fs(xs.size());
+			util::ParallelFor(pool.get(), xs.size(), [&](std::size_t i) { fs[i] = static_cast<P>(func(xs[i])); });
+			data->points.clear();
+			for (std::size_t i = 0; i < xs.size(); i++)
+			{
+				data->points.emplace_back(xs[i], static_cast<V>(fs[i]));
+				if (!haveBest || fs[i] < data->best.v)
+					data->best = data->points.back(), haveBest = true;
+			}
+			return fs;
+		};
+
+		P slope = 0; // max |f(r) - f(l)| / (r - l)
+		P m = 1;
+		auto characteristic = [&](Interval& in) {
+			P d = in.r - in.l, df = in.fr - in.fl;
+			in.characteristic = m * d + df * df / (m * d) - 2 * (in.fr + in.fl);
+		};
+		std::vector<Interval> heap;
+		auto addInterval = [&](P l, P fl, P r, P fr) {
+			if (!(l < r))
+				return;
+			slope = std::max(slope, abs(fr - fl) / (r - l));
+			heap.push_back({l, r, fl, fr, 0});
+		};
+		auto rebuild = [&]() {
+			m = slope > 0 ? reliability * slope : 1;
+			data->lipschitz = m;
+			for (auto& in : heap)
+				characteristic(in);
+			std::make_heap(heap.begin(), heap.end());
+		};
+
+		// initial uniform grid
+		{
+			P a = r.p - r.r, b = r.p + r.r;
+			std::vector<P> xs(k + 2);
+			for (std::size_t i = 0; i < xs.size(); i++)
+				xs[i] = a + (b - a) * static_cast<P>(i) / static_cast<P>(k + 1);
+			auto fs = evaluate(xs);
+			for (std::size_t i = 1; i < xs.size(); i++)
+				addInterval(xs[i - 1], fs[i - 1], xs[i], fs[i]);
+			rebuild();
+		}
+
+		for (std::size_t iter = 0; iter < maxIterations; iter++)
+		{
+			if (heap.empty()) // degenerate region, all intervals are empty
+				break;
+
+			// top k intervals
+			std::vector<Interval> chosen;
+			while (chosen.size() < k && !heap.empty())
+			{
+				std::pop_heap(heap.begin(), heap.end());
+				chosen.push_back(heap.back());
+				heap.pop_back();
+			}
+			P width = chosen.front().r - chosen.front().l;
+			if (width < epsilon)
+				break;
+
+			std::vector<P> xs;
+			for (auto const& in : chosen)
+				xs.push_back(std::clamp((in.l + in.r) / 2 - (in.fr - in.fl) / (2 * m), in.l, in.r));
+			auto fs = evaluate(xs);
+
+			P oldSlope = slope;
+			std::size_t from = heap.size();
+			for (std::size_t i = 0; i < chosen.size(); i++)
+			{
+				addInterval(chosen[i].l, chosen[i].fl, xs[i], fs[i]);
+				addInterval(xs[i], fs[i], chosen[i].r, chosen[i].fr);
+			}
+			if (slope != oldSlope)
+				rebuild();
+			else
+				for (std::size_t i = from; i < heap.size(); i++)
+				{
+					characteristic(heap[i]);
+					std::push_heap(heap.begin(), heap.begin() + i + 1);
+				}
+
+			co_yield {data->best.p, width};
+		}
+		co_yield {data->best.p, 0};
+	}
+};
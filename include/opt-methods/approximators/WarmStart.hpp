@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+
+#include "opt-methods/solvers/BaseApproximator.hpp"
+
+namespace impl
+{
+	/**
+	 * remembers last K evaluated points of one-dimensional function, forwards grad()
+	 */
+	template<typename P, typename V, typename F, std::size_t K>
+	class RecentPoints
+	{
+	public:
+		struct Storage
+		{
+			std::array<std::pair<P, V>, K> points;
+			std::size_t size = 0, next = 0;
+			std::size_t reused = 0;
+		};
+
+	private:
+		F const* func;
+		Storage* storage;
+
+	public:
+		RecentPoints(F const& func, Storage& storage)
+		: func(&func)
+		, storage(&storage)
+		{}
+
+		V operator()(P const& x) const
+		{
+			auto& st = *storage;
+			for (std::size_t i = 0; i < st.size; i++)
+				if (st.points[i].first == x)
+				{
+					st.reused++;
+					return st.points[i].second;
+				}
+			V res = (*func)(x);
+			st.points[st.next] = {x, res};
+			st.next = (st.next + 1) % K;
+			st.size = std::max(st.size, st.next == 0 ? K : st.next);
+			return res;
+		}
+
+		auto grad() const requires HasGrad<F>
+		{
+			return func->grad();
+		}
+	};
+}
+
+/**
+ * line search remembering previous accepted step of outer run:
+ * bounds are seeded from it and expanded while minimum is found at their right end
+ * outer methods take fresh copy for every run (see impl::ForRun), so runs neither share state nor race on it
+ */
+template<std::floating_point From, typename To, Approximator<From, To> OneDimApprox>
+class WarmStartApproximator : public BaseApproximator<From, To, WarmStartApproximator<From, To, OneDimApprox>>
+{
+	using BaseT = BaseApproximator<From, To, WarmStartApproximator>;
+
+public:
+	using P = From;
+	using V = To;
+
+	struct IterationData : BaseT::IterationData
+	{
+		P bound{};                 // right end of bounds used by last attempt
+		std::size_t expansions = 0; // since search start
+		std::size_t reusedPoints = 0;
+	};
+
+	static char const* name() noexcept { return "warm start"; }
+
+private:
+	OneDimApprox onedim;
+	mutable P lastStep = 0; // of current outer run
+
+public:
+	/// first bounds are lastStep * grow, they are multiplied by expand while minimum is near right end (expand <= 1 disables it)
+	P grow, expand, edge;
+
+	WarmStartApproximator(OneDimApprox onedim, P grow = 2, P expand = 4, P edge = P(0.05))
+	: onedim(std::move(onedim))
+	, grow(grow)
+	, expand(expand)
+	, edge(edge)
+	{}
+
+	/// copy without previous step, for new outer run
+	WarmStartApproximator forRun() const
+	{
+		auto res = *this;
+		res.lastStep = 0;
+		return res;
+	}
+
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	{
+		BEGIN_APPROX_COROUTINE(data);
+
+		using Recent = impl::RecentPoints<P, V, F, 4>;
+		typename Recent::Storage storage;
+		Recent recent(func, storage);
+
+		P lo = r.p - r.r, maxBound = 2 * r.r;
+		P bound = lastStep > 0 ? std::min(maxBound, grow * lastStep) : maxBound;
+		while (true)
+		{
+			data->bound = bound;
+			auto res = impl::Minimize<P, V>(onedim, recent, {lo, lo + bound, bound_tag});
+			data->reusedPoints = storage.reused;
+			if (!res.has_value())
+				break;
+			P step = res->p - lo;
+			if (expand > 1 && bound < maxBound && step >= (1 - edge) * bound)
+			{
+				data->expansions++;
+				bound = std::min(maxBound, bound * expand);
+				co_yield {lo + bound / 2, bound / 2};
+				continue;
+			}
+			if (step > 0)
+				lastStep = step;
+			co_yield *res;
+			break;
+		}
+	}
+};
@@ -1,7 +1,15 @@
 #pragma once
 
+#include "./BatchedGoldenSection.hpp"
+#include "./Bracketing.hpp"
 #include "./Brent.hpp"
+#include "./DBrent.hpp"
 #include "./Dichotomy.hpp"
 #include "./Fibonacci.hpp"
+#include "./Fixed.hpp"
 #include "./GoldenSection.hpp"
+#include "./KSection.hpp"
+#include "./LineSearch.hpp"
 #include "./Parabolic.hpp"
+#include "./Strongin.hpp"
+#include "./WarmStart.hpp"
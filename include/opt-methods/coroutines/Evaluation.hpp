@@ -0,0 +1,148 @@
+#pragma once
+
+#include <concepts>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace impl
+{
+	/**
+	 * completion of evaluation computed elsewhere, independent of value type
+	 */
+	class EvaluationStateBase
+	{
+	protected:
+		std::mutex m;
+		std::condition_variable cv;
+		bool ready = false;
+		std::exception_ptr error;
+		std::function<void()> continuation;
+
+		void finish(std::unique_lock<std::mutex>& lock)
+		{
+			ready = true;
+			auto cont = std::move(continuation);
+			lock.unlock();
+			cv.notify_all();
+			if (cont)
+				cont();
+		}
+
+	public:
+		virtual ~EvaluationStateBase() = default;
+
+		bool isReady()
+		{
+			std::unique_lock lock(m);
+			return ready;
+		}
+
+		void wait()
+		{
+			std::unique_lock lock(m);
+			cv.wait(lock, [this]() { return ready; });
+		}
+
+		/**
+		 * calls cont once evaluation is done, immediately if it already is
+		 */
+		void then(std::function<void()> cont)
+		{
+			std::unique_lock lock(m);
+			if (!ready)
+			{
+				continuation = std::move(cont);
+				return;
+			}
+			lock.unlock();
+			cont();
+		}
+
+		void fail(std::exception_ptr e)
+		{
+			std::unique_lock lock(m);
+			error = std::move(e);
+			finish(lock);
+		}
+	};
+
+	template<typename T>
+	class EvaluationState : public EvaluationStateBase
+	{
+	private:
+		std::optional<T> value;
+
+	public:
+		void complete(T v)
+		{
+			std::unique_lock lock(m);
+			value.emplace(std::move(v));
+			finish(lock);
+		}
+
+		T get()
+		{
+			std::unique_lock lock(m);
+			if (error)
+				std::rethrow_exception(error);
+			return *value;
+		}
+	};
+}
+
+/**
+ * value that is either known or being computed, approximators co_await it
+ * suspension is recorded in promise (see ApproxPromise), whoever resumes the coroutine waits for completion first
+ */
+template<typename T>
+class Evaluation
+{
+private:
+	std::optional<T> value;
+	std::shared_ptr<impl::EvaluationState<T>> state;
+
+public:
+	Evaluation(T value)
+	: value(std::move(value))
+	{}
+
+	explicit Evaluation(std::shared_ptr<impl::EvaluationState<T>> state)
+	: state(std::move(state))
+	{}
+
+	bool await_ready() const { return value.has_value() || state->isReady(); }
+
+	template<typename Promise>
+	void await_suspend(std::coroutine_handle<Promise> h) const
+	{
+		h.promise().awaiting = state;
+	}
+
+	T await_resume() { return value.has_value() ? std::move(*value) : state->get(); }
+};
+
+/**
+ * function which can start evaluation without waiting for it
+ */
+template<typename F, typename P, typename V>
+concept AsyncEvaluable = requires(F const& f, P const& x) {
+	{ f.evaluate(x) } -> std::same_as<Evaluation<V>>;
+};
+
+/**
+ * starts evaluation of func at x, synchronous functions are computed immediately
+ */
+template<typename P, typename V, typename F>
+Evaluation<V> Evaluate(F const& func, P const& x)
+{
+	if constexpr (AsyncEvaluable<F, P, V>)
+		return func.evaluate(x);
+	else
+		return Evaluation<V>(func(x));
+}
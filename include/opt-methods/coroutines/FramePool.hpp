@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+namespace util
+{
+	/**
+	 * thread-local free lists of coroutine frames grouped by size class
+	 * frames freed on another thread go to that thread's lists, lists are bounded,
+	 * frames larger than maxSize are not cached, all frames come from malloc and go back to free
+	 */
+	class FramePool
+	{
+	public:
+		static constexpr std::size_t granularity = 64;
+		static constexpr std::size_t classes = 64;
+		static constexpr std::size_t maxSize = granularity * classes;
+		static constexpr std::size_t maxCached = 32; // per size class
+
+		struct Stats
+		{
+			std::size_t allocated = 0; // taken from malloc
+			std::size_t reused = 0;    // taken from free list
+			std::size_t released = 0;  // returned to free
+		};
+
+	private:
+		struct Node
+		{
+			Node* next;
+		};
+
+		std::array<Node*, classes> heads{};
+		std::array<std::size_t, classes> sizes{};
+		Stats st;
+
+		static constexpr std::size_t ClassOf(std::size_t size) noexcept { return (size - 1) / granularity; }
+
+		void* fresh(std::size_t size)
+		{
+			st.allocated++;
+			if (void* res = std::malloc(size != 0 ? size : 1))
+				return res;
+			throw std::bad_alloc();
+		}
+
+		/**
+		 * kept out of line: after inlining into coroutine gcc would see free of pointer
+		 * returned from PooledFrame::operator new and warn about mismatched deallocation
+		 */
+		[[gnu::noinline]] void release(void* ptr) noexcept
+		{
+			st.released++;
+			std::free(ptr);
+		}
+
+		FramePool() = default;
+
+	public:
+		FramePool(FramePool const&) = delete;
+		FramePool& operator=(FramePool const&) = delete;
+
+		~FramePool()
+		{
+			for (auto& head : heads)
+				while (head != nullptr)
+					std::free(std::exchange(head, head->next));
+		}
+
+		static FramePool& local() noexcept
+		{
+			thread_local FramePool pool;
+			return pool;
+		}
+
+		void* allocate(std::size_t size)
+		{
+			if (size == 0 || size > maxSize)
+				return fresh(size);
+			auto c = ClassOf(size);
+			if (heads[c] != nullptr)
+			{
+				st.reused++;
+				sizes[c]--;
+				return std::exchange(heads[c], heads[c]->next);
+			}
+			return fresh((c + 1) * granularity);
+		}
+
+		/**
+		 * @param size -- same as passed to allocate
+		 */
+		void deallocate(void* ptr, std::size_t size) noexcept
+		{
+			if (size == 0 || size > maxSize || sizes[ClassOf(size)] >= maxCached)
+			{
+				release(ptr);
+				return;
+			}
+			auto c = ClassOf(size);
+			heads[c] = ::new (ptr) Node{heads[c]};
+			sizes[c]++;
+		}
+
+		Stats const& stats() const noexcept { return st; }
+	};
+
+	/**
+	 * base for promise types, makes coroutine frames come from FramePool
+	 */
+	struct PooledFrame
+	{
+		static void* operator new(std::size_t size) { return FramePool::local().allocate(size); }
+		static void operator delete(void* ptr, std::size_t size) noexcept { FramePool::local().deallocate(ptr, size); }
+	};
+}
@@ -95,9 +95,10 @@ struct Generator
 		return static_cast<bool>(handle);
 	}
 
+	/// false if coroutine has not yielded
 	bool hasValue() const
 	{
-		return handle.promise().value.index() == 0;
+		return handle.promise().value.index() == 0 && std::get<0>(handle.promise().value) != nullptr;
 	}
 
 	T const& getValue() const
@@ -1,9 +1,13 @@
 #pragma once
 
 #include "opt-methods/solvers/BaseApproximator.hpp"
+#include "opt-methods/solvers/Convergence.hpp"
 
-template<typename From, typename To>
-class Marquardt1 : public BaseApproximator<From, To, Marquardt1<From, To>>
+/**
+ * @tparam Convergence -- stops earlier than step length check if converged
+ */
+template<typename From, typename To, ConvergencePolicy<From, To> Convergence = BuiltinConvergence>
+class Marquardt1 : public BaseApproximator<From, To, Marquardt1<From, To, Convergence>>
 {
 private:
 	using BaseT = BaseApproximator<From, To, Marquardt1>;
@@ -22,26 +26,62 @@ public:
 
 	S epsilon2;
 	S tau0, beta;
+	Convergence convergence;
 
-	Marquardt1(S epsilon, S tau0, S beta)
+	Marquardt1(S epsilon, S tau0, S beta, Convergence convergence = {})
 	: epsilon2(epsilon * epsilon)
 	, tau0(tau0)
 	, beta(beta)
+	, convergence(std::move(convergence))
 	{}
 
+	/// carried between iterations
+	struct State
+	{
+		P x;
+		S tau0;
+
+		template<typename Archive>
+		void serialize(Archive& ar)
+		{
+			ar(x, tau0);
+		}
+	};
+
 	template<Function<P, V> F>
 	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	{
+		return resumable(std::move(func), std::move(r), {}, nullptr);
+	}
+
+	/// operator() with checkpoints, resumes from snapshot if given, yields nothing if snapshot does not match
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> resumable(F func_, PointRegion<P> r, util::Checkpointing checkpoints, util::Snapshot const* from) const
 	{
 		BEGIN_APPROX_COROUTINE(data);
 
+		impl::ConvergenceTracker<P, V, Convergence> tracker(convergence);
+		auto func = tracker.track(std::move(func_));
+
 		auto I = DenseMatrix<S>::Identity(r.p.size());
 
-		P x = r.p, p;
+		State state{r.p, this->tau0};
+		std::size_t iteration = 0;
+		if (from != nullptr)
+		{
+			if (!util::RestoreSnapshot(*from, util::Dimension(r.p), state, tracker))
+				co_return;
+			iteration = from->iteration;
+		}
+
+		P& x = state.x;
+		P p;
 		V fx;
 		auto gradf = func.grad();
 		auto hessf = func.hessian();
 
-		S tau0 = this->tau0, tau;
+		S& tau0 = state.tau0;
+		S tau;
 
 		while (true)
 		{
@@ -55,6 +95,7 @@ public:
 			while (true)
 			{
 				p = DenseMatrix<S>(hess + I * tau).SolveSystem(-grad);
+				impl::Count(&EvaluationCounters::linearSolves);
 				y = x + p, fy = func(y);
 				if (fy > fx)
 					tau /= beta;
@@ -64,7 +105,10 @@ public:
 			x = y, fx = fy, tau0 *= beta;
 
 			if (Len2(p) < epsilon2) break;
+			if (tracker.converged(x, [&]() { return fx; }, [&]() { return gradf(x); })) break;
 			data->tau = tau;
+			if (checkpoints.due(++iteration))
+				checkpoints.save(util::TakeSnapshot(iteration, util::Dimension(r.p), state, tracker));
 			co_yield {x, 0};
 		}
 	}
@@ -3,8 +3,11 @@
 #include "opt-methods/solvers/BaseApproximator.hpp"
 #include "./Marquardt1.hpp"
 
-template<typename From, typename To>
-class Marquardt2 : public BaseApproximator<From, To, Marquardt2<From, To>>
+/**
+ * @tparam Convergence -- stops earlier than step length check if converged
+ */
+template<typename From, typename To, ConvergencePolicy<From, To> Convergence = BuiltinConvergence>
+class Marquardt2 : public BaseApproximator<From, To, Marquardt2<From, To, Convergence>>
 {
 private:
 	using BaseT = BaseApproximator<From, To, Marquardt2>;
@@ -22,24 +25,60 @@ public:
 	using S = Scalar<P>;
 
 	S epsilon2, beta;
+	Convergence convergence;
 
-	Marquardt2(S epsilon, S beta)
+	Marquardt2(S epsilon, S beta, Convergence convergence = {})
 	: epsilon2(epsilon * epsilon)
 	, beta(beta)
+	, convergence(std::move(convergence))
 	{}
 
+	/// carried between iterations
+	struct State
+	{
+		P x;
+		S tau;
+
+		template<typename Archive>
+		void serialize(Archive& ar)
+		{
+			ar(x, tau);
+		}
+	};
+
 	template<Function<P, V> F>
 	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	{
+		return resumable(std::move(func), std::move(r), {}, nullptr);
+	}
+
+	/// operator() with checkpoints, resumes from snapshot if given, yields nothing if snapshot does not match
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> resumable(F func_, PointRegion<P> r, util::Checkpointing checkpoints, util::Snapshot const* from) const
 	{
 		BEGIN_APPROX_COROUTINE(data);
 
+		impl::ConvergenceTracker<P, V, Convergence> tracker(convergence);
+		auto func = tracker.track(std::move(func_));
+
 		auto I = DenseMatrix<S>::Identity(r.p.size());
 
-		P x = r.p, p;
+		State state{r.p, 0};
+		std::size_t iteration = 0;
+		if (from != nullptr)
+		{
+			if (!util::RestoreSnapshot(*from, util::Dimension(r.p), state, tracker))
+				co_return;
+			iteration = from->iteration;
+			state.tau *= beta; // snapshot is taken before yield
+		}
+
+		P& x = state.x;
+		P p;
 		auto gradf = func.grad();
 		auto hessf = func.hessian();
 
-		S tau = 0;
+		S& tau = state.tau;
 
 		while (true)
 		{
@@ -49,14 +88,19 @@ public:
 			while (!CholeskySolveSystem(DenseMatrix<S>(hess + I * tau), -grad, p))
 			{
 				data->nCholesky++;
+				impl::Count(&EvaluationCounters::linearSolves);
 				using std::max;
 				tau = max<S>(1, 2 * tau);
 			}
 			data->tau = tau;
 			data->nCholesky++;
+			impl::Count(&EvaluationCounters::linearSolves);
 			x += p;
 
 			if (Len2(p) < epsilon2) break;
+			if (tracker.converged(x, [&]() { return func(x); }, [&]() { return gradf(x); })) break;
+			if (checkpoints.due(++iteration))
+				checkpoints.save(util::TakeSnapshot(iteration, util::Dimension(r.p), state, tracker));
 			co_yield {x, 0};
 			tau *= beta;
 		}
@@ -9,12 +9,13 @@
 #include "./Vector.hpp"
 #include "./Matrix.hpp"
 #include "./DenseMatrix.hpp"
+#include "./SharedMatrix.hpp"
 
 template<typename T, Matrix<T> MatrixImpl = DenseMatrix<T>>
 class QuadraticFunction
 {
 public:
-	const MatrixImpl A;
+	const SharedMatrix<MatrixImpl> A;
 	const Vector<T> b;
 	const T c;
 
@@ -31,7 +32,7 @@ public:
 		/// TEST ME
 		Vector<T> b_rev = b;
 		std::reverse(std::begin(b_rev), std::end(b_rev));
-		return QuadraticFunction(A.Transpose(), b_rev, c);
+		return QuadraticFunction(A->Transpose(), b_rev, c);
 	}
 
 	T operator()(Vector<T> const& v) const
@@ -43,13 +44,13 @@ public:
 	class HessianFunc
 	{
 	private:
-		MatrixImpl A;
+		SharedMatrix<MatrixImpl> A;
 	public:
-		HessianFunc(MatrixImpl A)
+		HessianFunc(SharedMatrix<MatrixImpl> A)
 		: A(std::move(A))
 		{}
 
-		MatrixImpl operator()(Vector<T> const&) const noexcept
+		SharedMatrix<MatrixImpl> operator()(Vector<T> const&) const noexcept
 		{
 			return A;
 		}
@@ -59,9 +60,9 @@ public:
 	private:
 		friend QuadraticFunction;
 
-		MatrixImpl A;
+		SharedMatrix<MatrixImpl> A;
 		Vector<T> b;
-		GradientFunc(MatrixImpl A, Vector<T> b)
+		GradientFunc(SharedMatrix<MatrixImpl> A, Vector<T> b)
 		: A(std::move(A))
 		, b(std::move(b))
 		{}
@@ -81,6 +82,12 @@ public:
 	{
 		return {A};
 	}
+
+	Vector<T> hessVec(Vector<T> const&, Vector<T> const& v) const
+	{
+		assert(v.size() == A.Dims());
+		return A * v;
+	}
 };
 
 template<typename T, Matrix<T> MatrixImpl>
@@ -96,7 +103,7 @@ public:
 
 	std::tuple<T, T, T, T, T> get2d_coefs() const
 	{
-		auto& A = this->A;
+		auto& A = *this->A;
 		auto& b = this->b;
 		return {A.data[0] / 2, (A.data[1] + A.data[2]) / 2, A.data[3] / 2, b[0], b[1]};
 	}
@@ -209,11 +209,46 @@ private:
 	}
 
 public :
-	Vector<T> SolveSystem(Vector<T> b) &&
+	/**
+	 * gaussian elimination with row permutation, multipliers are kept in place of eliminated elements,
+	 * so systems with the same matrix are solved without repeating it
+	 */
+	class Factorization
+	{
+	private:
+		friend DenseMatrix;
+
+		DenseMatrix lu;
+		std::vector<int> pi;
+
+		Factorization(DenseMatrix lu, std::vector<int> pi)
+		: lu(std::move(lu))
+		, pi(std::move(pi))
+		{}
+
+	public:
+		Vector<T> Solve(Vector<T> b) const
+		{
+			size_t n = lu.n;
+			assert(b.size() == n);
+			for (size_t k = 0; k + 1 < n; k++)
+				for (size_t i = k + 1; i < n; i++)
+					b[pi[i]] -= lu.At(pi[i], k) * b[pi[k]];
+
+			Vector<T> x(b.size());
+			for (size_t k = n; k > 0; k--)
+				x[k - 1] = (b[pi[k - 1]] - std::transform_reduce(
+				                               lu.IteratorAt(pi[k - 1], k), lu.IteratorAt(pi[k - 1] + 1, 0), std::begin(x) + k, util::zero<T>)) /
+				           lu.At(pi[k - 1], k - 1);
+			return x;
+		}
+	};
+
+	Factorization Factorize() &&
 	{
 		std::vector<int> pi = unitPermutation(n);
 
-		for (size_t k = 0; k < n - 1; k++)
+		for (size_t k = 0; k + 1 < n; k++)
 		{
 			auto [a_mk1, a_mk2] = std::minmax_element(util::PermutedStridedIterator(std::begin(data), n, k, k, n, pi),
 			                                          util::PermutedStridedIterator(std::begin(data), n, n, k, 0, pi));
@@ -224,7 +259,7 @@ public :
 			for (size_t i = k + 1; i < n; i++)
 			{
 				T t = At(pi[i], k) / At(pi[k], k);
-				b[pi[i]] -= t * b[pi[k]];
+				At(pi[i], k) = t;
 
 				std::transform(IteratorAt(pi[i], k + 1),
 				               IteratorAt(pi[i] + 1, 0),
@@ -233,12 +268,12 @@ public :
 				               [&t](T const& lhs, T const& rhs) { return lhs - t * rhs; });
 			}
 		}
-		Vector<T> x(b.size());
-		for (size_t k = n; k > 0; k--)
-			x[k - 1] = (b[pi[k - 1]] - std::transform_reduce(
-			                               IteratorAt(pi[k - 1], k), IteratorAt(pi[k - 1] + 1, 0), std::begin(x) + k, util::zero<T>)) /
-			           At(pi[k - 1], k - 1);
-		return x;
+		return Factorization(std::move(*this), std::move(pi));
+	}
+
+	Vector<T> SolveSystem(Vector<T> b) &&
+	{
+		return std::move(*this).Factorize().Solve(std::move(b));
 	}
 
 	void WriteTo(std::filesystem::path const& p) const
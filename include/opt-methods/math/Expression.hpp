@@ -0,0 +1,447 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "./Vector.hpp"
+#include "./DenseMatrix.hpp"
+
+/**
+ * compile-time symbolic expressions
+ * every expression is an empty type, so equal subexpressions have equal types:
+ * derivatives are built and simplified by overload resolution, common subexpressions are shared by type
+ * constants are template parameters too (`c<100>`), runtime numbers cannot be mixed in
+ */
+namespace expr
+{
+	template<typename Op, typename... Args>
+	struct Node
+	{
+		using is_expr = void;
+	};
+
+	template<std::size_t I>
+	struct Var
+	{
+		using is_expr = void;
+	};
+
+	template<double V>
+	struct Constant
+	{
+		using is_expr = void;
+		static constexpr double value = V;
+	};
+
+	template<typename T>
+	concept Expr = requires { typename T::is_expr; };
+
+	template<typename T>
+	struct IsConstant : std::false_type {};
+	template<double V>
+	struct IsConstant<Constant<V>> : std::true_type {};
+
+	using Zero = Constant<0.0>;
+	using One  = Constant<1.0>;
+
+	template<std::size_t I>
+	inline constexpr Var<I> x{};
+	template<auto V>
+	inline constexpr Constant<double(V)> c{};
+
+	namespace op
+	{
+		struct Add { static auto Eval(auto a, auto b) { return a + b; } };
+		struct Sub { static auto Eval(auto a, auto b) { return a - b; } };
+		struct Mul { static auto Eval(auto a, auto b) { return a * b; } };
+		struct Div { static auto Eval(auto a, auto b) { return a / b; } };
+		struct Neg { static auto Eval(auto a) { return -a; } };
+		struct Exp { static auto Eval(auto a) { using std::exp; return exp(a); } };
+		struct Log { static auto Eval(auto a) { using std::log; return log(a); } };
+		struct Sin { static auto Eval(auto a) { using std::sin; return sin(a); } };
+		struct Cos { static auto Eval(auto a) { using std::cos; return cos(a); } };
+		struct Sqrt { static auto Eval(auto a) { using std::sqrt; return sqrt(a); } };
+		struct Atan { static auto Eval(auto a) { using std::atan; return atan(a); } };
+
+		template<int N>
+		struct Pow
+		{
+			static auto Eval(auto a)
+			{
+				auto res = a;
+				for (int i = 1; i < N; i++)
+					res *= a;
+				return res;
+			}
+		};
+	}
+
+	/* builders with simplification */
+
+	template<Expr E>
+	constexpr auto operator-(E)
+	{
+		if constexpr (IsConstant<E>::value)
+			return Constant<-E::value>{};
+		else
+			return Node<op::Neg, E>{};
+	}
+	template<Expr E>
+	constexpr auto operator-(Node<op::Neg, E>)
+	{
+		return E{};
+	}
+
+	template<Expr L, Expr R>
+	constexpr auto operator*(L, R)
+	{
+		if constexpr (IsConstant<L>::value && IsConstant<R>::value)
+			return Constant<L::value * R::value>{};
+		else if constexpr (std::is_same_v<L, Zero> || std::is_same_v<R, Zero>)
+			return Zero{};
+		else if constexpr (std::is_same_v<L, One>)
+			return R{};
+		else if constexpr (std::is_same_v<R, One>)
+			return L{};
+		else if constexpr (IsConstant<R>::value)
+			return R{} * L{}; // constants go first
+		else
+			return Node<op::Mul, L, R>{};
+	}
+	template<double A, double B, Expr E>
+	constexpr auto operator*(Constant<A>, Node<op::Mul, Constant<B>, E>)
+	{
+		return Constant<A * B>{} * E{};
+	}
+
+	template<Expr L, Expr R>
+	constexpr auto operator+(L, R)
+	{
+		if constexpr (IsConstant<L>::value && IsConstant<R>::value)
+			return Constant<L::value + R::value>{};
+		else if constexpr (std::is_same_v<L, Zero>)
+			return R{};
+		else if constexpr (std::is_same_v<R, Zero>)
+			return L{};
+		else if constexpr (std::is_same_v<L, R>)
+			return Constant<2.0>{} * L{};
+		else
+			return Node<op::Add, L, R>{};
+	}
+
+	template<Expr L, Expr R>
+	constexpr auto operator-(L, R)
+	{
+		if constexpr (IsConstant<L>::value && IsConstant<R>::value)
+			return Constant<L::value - R::value>{};
+		else if constexpr (std::is_same_v<L, R>)
+			return Zero{};
+		else if constexpr (std::is_same_v<R, Zero>)
+			return L{};
+		else if constexpr (std::is_same_v<L, Zero>)
+			return -R{};
+		else
+			return Node<op::Sub, L, R>{};
+	}
+
+	template<Expr L, Expr R>
+	constexpr auto operator/(L, R)
+	{
+		static_assert(!std::is_same_v<R, Zero>, "division by zero");
+		if constexpr (IsConstant<L>::value && IsConstant<R>::value)
+			return Constant<L::value / R::value>{};
+		else if constexpr (std::is_same_v<L, Zero>)
+			return Zero{};
+		else if constexpr (std::is_same_v<R, One>)
+			return L{};
+		else if constexpr (std::is_same_v<L, R>)
+			return One{};
+		else
+			return Node<op::Div, L, R>{};
+	}
+
+	template<int N, Expr E>
+	constexpr auto pow(E)
+	{
+		static_assert(N >= 0, "only natural powers are supported");
+		if constexpr (N == 0)
+			return One{};
+		else if constexpr (N == 1)
+			return E{};
+		else if constexpr (IsConstant<E>::value)
+			return E{} * pow<N - 1>(E{});
+		else
+			return Node<op::Pow<N>, E>{};
+	}
+	template<int N, int M, Expr E>
+	constexpr auto pow(Node<op::Pow<M>, E>)
+	{
+		return pow<N * M>(E{});
+	}
+
+	// extra defaulted parameter makes these more constrained than generic ones from def.hpp
+	template<Expr E, typename R = E>
+	constexpr auto square(E const&) { return pow<2>(E{}); }
+	template<Expr E, typename R = E>
+	constexpr auto cube(E const&) { return pow<3>(E{}); }
+	template<Expr E, typename R = E>
+	constexpr auto quad(E const&) { return pow<4>(E{}); }
+
+	template<Expr E>
+	constexpr auto exp(E) { return Node<op::Exp, E>{}; }
+	template<Expr E>
+	constexpr auto log(E) { return Node<op::Log, E>{}; }
+	template<Expr E>
+	constexpr auto sin(E) { return Node<op::Sin, E>{}; }
+	template<Expr E>
+	constexpr auto cos(E) { return Node<op::Cos, E>{}; }
+	template<Expr E>
+	constexpr auto sqrt(E) { return Node<op::Sqrt, E>{}; }
+	template<Expr E>
+	constexpr auto atan(E) { return Node<op::Atan, E>{}; }
+
+	/* differentiation */
+
+	template<std::size_t I, std::size_t J>
+	constexpr auto Derive(Var<J>)
+	{
+		if constexpr (I == J)
+			return One{};
+		else
+			return Zero{};
+	}
+	template<std::size_t I, double V>
+	constexpr auto Derive(Constant<V>) { return Zero{}; }
+
+	template<std::size_t I, Expr A, Expr B>
+	constexpr auto Derive(Node<op::Add, A, B>) { return Derive<I>(A{}) + Derive<I>(B{}); }
+	template<std::size_t I, Expr A, Expr B>
+	constexpr auto Derive(Node<op::Sub, A, B>) { return Derive<I>(A{}) - Derive<I>(B{}); }
+	template<std::size_t I, Expr A, Expr B>
+	constexpr auto Derive(Node<op::Mul, A, B>) { return Derive<I>(A{}) * B{} + A{} * Derive<I>(B{}); }
+	template<std::size_t I, Expr A, Expr B>
+	constexpr auto Derive(Node<op::Div, A, B>)
+	{
+		// (a / b)' = (a' - (a / b) * b') / b, quotient itself is shared with value
+		return (Derive<I>(A{}) - Node<op::Div, A, B>{} * Derive<I>(B{})) / B{};
+	}
+	template<std::size_t I, Expr A>
+	constexpr auto Derive(Node<op::Neg, A>) { return -Derive<I>(A{}); }
+	template<std::size_t I, Expr A>
+	constexpr auto Derive(Node<op::Exp, A>) { return Node<op::Exp, A>{} * Derive<I>(A{}); }
+	template<std::size_t I, Expr A>
+	constexpr auto Derive(Node<op::Log, A>) { return Derive<I>(A{}) / A{}; }
+	template<std::size_t I, Expr A>
+	constexpr auto Derive(Node<op::Sin, A>) { return cos(A{}) * Derive<I>(A{}); }
+	template<std::size_t I, Expr A>
+	constexpr auto Derive(Node<op::Cos, A>) { return -(sin(A{}) * Derive<I>(A{})); }
+	template<std::size_t I, Expr A>
+	constexpr auto Derive(Node<op::Sqrt, A>) { return Derive<I>(A{}) / (c<2> * Node<op::Sqrt, A>{}); }
+	template<std::size_t I, Expr A>
+	constexpr auto Derive(Node<op::Atan, A>) { return Derive<I>(A{}) / (One{} + pow<2>(A{})); }
+	template<std::size_t I, int N, Expr A>
+	constexpr auto Derive(Node<op::Pow<N>, A>) { return Constant<double(N)>{} * pow<N - 1>(A{}) * Derive<I>(A{}); }
+
+	/* common subexpression elimination: unique subexpressions in evaluation order */
+
+	template<typename... Ts>
+	struct TypeList
+	{
+		static constexpr std::size_t size = sizeof...(Ts);
+	};
+
+	template<typename T, typename List>
+	struct IndexOf;
+	template<typename T, typename... Ts>
+	struct IndexOf<T, TypeList<Ts...>>
+	{
+		static constexpr std::size_t value = []() {
+			constexpr bool same[] = {std::is_same_v<T, Ts>..., true};
+			std::size_t i = 0;
+			while (!same[i])
+				i++;
+			return i;
+		}();
+	};
+
+	template<typename T, typename List>
+	constexpr bool Contains = IndexOf<T, List>::value < List::size;
+
+	template<typename T>
+	struct Children
+	{
+		using type = TypeList<>;
+	};
+	template<typename Op, typename... Args>
+	struct Children<Node<Op, Args...>>
+	{
+		using type = TypeList<Args...>;
+	};
+
+	template<typename List, typename... Ts>
+	struct Collect
+	{
+		using type = List;
+	};
+	template<typename List, typename Ts>
+	struct CollectList;
+	template<typename List, typename... Ts>
+	struct CollectList<List, TypeList<Ts...>> : Collect<List, Ts...> {};
+
+	template<typename List, typename T, bool = Contains<T, List>>
+	struct CollectOne
+	{
+		using type = List;
+	};
+	template<typename... Ls, typename T>
+	struct CollectOne<TypeList<Ls...>, T, false>
+	{
+		template<typename... Cs>
+		static auto Append(TypeList<Cs...>) -> TypeList<Cs..., T>;
+
+		using type = decltype(Append(typename CollectList<TypeList<Ls...>, typename Children<T>::type>::type{}));
+	};
+
+	template<typename List, typename T, typename... Ts>
+	struct Collect<List, T, Ts...> : Collect<typename CollectOne<List, T>::type, Ts...> {};
+
+	template<typename T>
+	struct VarCount : std::integral_constant<std::size_t, 0> {};
+	template<std::size_t I>
+	struct VarCount<Var<I>> : std::integral_constant<std::size_t, I + 1> {};
+	template<typename Op, typename... Args>
+	struct VarCount<Node<Op, Args...>> : std::integral_constant<std::size_t, std::max({std::size_t(0), VarCount<Args>::value...})> {};
+
+	/**
+	 * straight-line evaluation of all listed subexpressions, each exactly once
+	 */
+	template<typename List>
+	struct Kernel;
+	template<typename... Ns>
+	struct Kernel<TypeList<Ns...>>
+	{
+		using List = TypeList<Ns...>;
+
+		template<typename E>
+		static constexpr std::size_t index = IndexOf<E, List>::value;
+
+		template<typename S, std::size_t J>
+		static S EvalNode(std::array<S, sizeof...(Ns)> const&, Vector<S> const& x, Var<J>) { return x[J]; }
+		template<typename S, double V>
+		static S EvalNode(std::array<S, sizeof...(Ns)> const&, Vector<S> const&, Constant<V>) { return S(V); }
+		template<typename S, typename Op, typename... Args>
+		static S EvalNode(std::array<S, sizeof...(Ns)> const& cache, Vector<S> const&, Node<Op, Args...>)
+		{
+			return Op::Eval(cache[index<Args>]...);
+		}
+
+		template<typename S>
+		static std::array<S, sizeof...(Ns)> Run(Vector<S> const& x)
+		{
+			std::array<S, sizeof...(Ns)> cache;
+			std::size_t k = 0;
+			((cache[k++] = EvalNode(cache, x, Ns{})), ...);
+			return cache;
+		}
+	};
+}
+
+/**
+ * function with fused value/gradient/hessian kernels generated from symbolic expression
+ */
+template<typename S, expr::Expr E>
+class SymbolicFunction
+{
+public:
+	static constexpr std::size_t n = expr::VarCount<E>::value;
+
+private:
+	template<std::size_t... I>
+	static auto GradTypes(std::index_sequence<I...>) -> expr::TypeList<decltype(expr::Derive<I>(E{}))...>;
+	template<std::size_t... K>
+	static auto HessTypes(std::index_sequence<K...>)
+	    -> expr::TypeList<decltype(expr::Derive<std::max(K / n, K % n)>(expr::Derive<std::min(K / n, K % n)>(E{})))...>;
+
+	using Grads = decltype(GradTypes(std::make_index_sequence<n>()));
+	using Hessians = decltype(HessTypes(std::make_index_sequence<n * n>()));
+
+	template<typename... Lists>
+	struct Join;
+	template<typename... As, typename... Bs>
+	struct Join<expr::TypeList<As...>, expr::TypeList<Bs...>>
+	{
+		using type = expr::TypeList<As..., Bs...>;
+	};
+
+	using ValueKernel = expr::Kernel<typename expr::Collect<expr::TypeList<>, E>::type>;
+	using GradKernel =
+	    expr::Kernel<typename expr::CollectList<expr::TypeList<>, typename Join<expr::TypeList<E>, Grads>::type>::type>;
+	using FullKernel = expr::Kernel<typename expr::CollectList<
+	    expr::TypeList<>, typename Join<typename Join<expr::TypeList<E>, Grads>::type, Hessians>::type>::type>;
+
+	template<typename Kernel, typename... Gs>
+	static Vector<S> ExtractGrad(auto const& cache, expr::TypeList<Gs...>)
+	{
+		return Vector<S>{cache[Kernel::template index<Gs>]...};
+	}
+	template<typename Kernel, typename... Hs>
+	static DenseMatrix<S> ExtractHessian(auto const& cache, expr::TypeList<Hs...>)
+	{
+		return DenseMatrix<S>(n, std::valarray<S>{cache[Kernel::template index<Hs>]...});
+	}
+
+public:
+	using P = Vector<S>;
+	using V = S;
+
+	S operator()(P const& x) const
+	{
+		assert(x.size() == n);
+		return ValueKernel::Run(x)[ValueKernel::template index<E>];
+	}
+
+	struct GradientFunc
+	{
+		P operator()(P const& x) const
+		{
+			assert(x.size() == n);
+			return ExtractGrad<GradKernel>(GradKernel::Run(x), Grads{});
+		}
+	};
+
+	struct HessianFunc
+	{
+		DenseMatrix<S> operator()(P const& x) const
+		{
+			assert(x.size() == n);
+			return ExtractHessian<FullKernel>(FullKernel::Run(x), Hessians{});
+		}
+	};
+
+	GradientFunc grad() const { return {}; }
+	HessianFunc hessian() const { return {}; }
+
+	/**
+	 * value, gradient and hessian in one pass
+	 */
+	std::tuple<S, P, DenseMatrix<S>> evaluate(P const& x) const
+	{
+		assert(x.size() == n);
+		auto cache = FullKernel::Run(x);
+		return {cache[FullKernel::template index<E>], ExtractGrad<FullKernel>(cache, Grads{}), ExtractHessian<FullKernel>(cache, Hessians{})};
+	}
+};
+
+/**
+ * @return function of Vector<S> computing e
+ */
+template<typename S, expr::Expr E>
+SymbolicFunction<S, E> Symbolic(E)
+{
+	return {};
+}
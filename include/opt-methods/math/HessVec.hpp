@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <concepts>
+
+#include "./Vector.hpp"
+#include "./Scalar.hpp"
+
+/**
+ * function that can multiply its hessian by vector without forming the matrix
+ */
+template<typename T, typename P>
+concept HasHessVec = requires(T const& t, P const& x, P const& v) {
+	{ t.hessVec(x, v) } -> std::same_as<P>;
+};
+
+/**
+ * hessian-vector product H(x) * v
+ * exact if function provides `hessVec`, forward difference of gradients otherwise
+ * @param gradx -- already computed grad(x), reused by finite difference
+ */
+template<typename F, typename G, typename P>
+P HessVec(F const& func, G const& grad, P const& x, P const& v, P const& gradx)
+{
+	if constexpr (HasHessVec<F, P>)
+		return func.hessVec(x, v);
+	else
+	{
+		using S = Scalar<P>;
+		using std::sqrt;
+		auto lenV = Len(v);
+		if (lenV == 0)
+			return P(S(0), v.size());
+		auto h = sqrt(std::numeric_limits<S>::epsilon()) * (1 + Len(x)) / lenV;
+		return P((grad(P(x + h * v)) - gradx) / h);
+	}
+}
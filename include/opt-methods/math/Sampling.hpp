@@ -0,0 +1,171 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+
+#include "./Vector.hpp"
+
+/**
+ * samplers of unit cube [0, 1)^dim, i-th point depends only on i (and seed),
+ * so points can be generated in any order on any thread
+ */
+template<typename T, typename S>
+concept UnitSampler = requires(T const& t, std::size_t i) {
+	{ t.dimension() } -> std::convertible_to<std::size_t>;
+	{ t(i) } -> std::same_as<Vector<S>>;
+};
+
+/**
+ * radical inverses in first primes
+ */
+template<std::floating_point S>
+class HaltonSampler
+{
+private:
+	static constexpr std::array<unsigned, 32> primes = {
+		2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53,
+		59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131};
+
+	std::size_t dim;
+
+public:
+	static constexpr std::size_t maxDimension = primes.size();
+
+	explicit HaltonSampler(std::size_t dim)
+	: dim(dim)
+	{
+		assert(dim <= maxDimension);
+	}
+
+	std::size_t dimension() const noexcept { return dim; }
+
+	Vector<S> operator()(std::size_t i) const
+	{
+		Vector<S> res(dim);
+		for (std::size_t d = 0; d < dim; d++)
+		{
+			S f = 1, r = 0;
+			for (std::size_t n = i + 1; n > 0; n /= primes[d]) // skip origin
+			{
+				f /= primes[d];
+				r += f * static_cast<S>(n % primes[d]);
+			}
+			res[d] = r;
+		}
+		return res;
+	}
+};
+
+/**
+ * Sobol sequence in gray code order with Joe-Kuo direction numbers
+ */
+template<std::floating_point S>
+class SobolSampler
+{
+private:
+	static constexpr std::size_t bits = 32;
+
+	struct Polynomial
+	{
+		unsigned s, a;
+		std::array<std::uint32_t, 5> m;
+	};
+	// dimensions 2.., dimension 1 is van der Corput sequence
+	static constexpr std::array<Polynomial, 9> polynomials = {{
+		{1, 0, {1}},
+		{2, 1, {1, 3}},
+		{3, 1, {1, 3, 1}},
+		{3, 2, {1, 1, 1}},
+		{4, 1, {1, 1, 3, 3}},
+		{4, 4, {1, 3, 5, 13}},
+		{5, 2, {1, 1, 5, 5, 17}},
+		{5, 4, {1, 1, 5, 5, 5}},
+		{5, 7, {1, 1, 7, 11, 19}},
+	}};
+
+	std::size_t dim;
+	std::array<std::array<std::uint32_t, bits>, polynomials.size() + 1> directions{};
+
+public:
+	static constexpr std::size_t maxDimension = polynomials.size() + 1;
+
+	explicit SobolSampler(std::size_t dim)
+	: dim(dim)
+	{
+		assert(dim <= maxDimension);
+		for (std::size_t k = 0; k < bits; k++)
+			directions[0][k] = std::uint32_t(1) << (bits - 1 - k);
+		for (std::size_t d = 1; d < maxDimension; d++)
+		{
+			auto const& [s, a, m] = polynomials[d - 1];
+			auto& v = directions[d];
+			for (std::size_t k = 0; k < s; k++)
+				v[k] = m[k] << (bits - 1 - k);
+			for (std::size_t k = s; k < bits; k++)
+			{
+				v[k] = v[k - s] ^ (v[k - s] >> s);
+				for (std::size_t j = 1; j < s; j++)
+					if ((a >> (s - 1 - j)) & 1)
+						v[k] ^= v[k - j];
+			}
+		}
+	}
+
+	std::size_t dimension() const noexcept { return dim; }
+
+	Vector<S> operator()(std::size_t i) const
+	{
+		auto gray = static_cast<std::uint64_t>(i ^ (i >> 1));
+		Vector<S> res(dim);
+		for (std::size_t d = 0; d < dim; d++)
+		{
+			std::uint32_t x = 0;
+			for (std::size_t k = 0; k < bits && (gray >> k) != 0; k++)
+				if ((gray >> k) & 1)
+					x ^= directions[d][k];
+			res[d] = static_cast<S>(x) / static_cast<S>(std::uint64_t(1) << bits);
+		}
+		return res;
+	}
+};
+
+/**
+ * pseudo-random points, i-th point is hash of seed and i
+ */
+template<std::floating_point S>
+class RandomSampler
+{
+private:
+	std::size_t dim;
+	std::uint64_t seed;
+
+	static std::uint64_t SplitMix(std::uint64_t x) noexcept
+	{
+		x += 0x9e3779b97f4a7c15ULL;
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+		return x ^ (x >> 31);
+	}
+
+public:
+	RandomSampler(std::size_t dim, std::uint64_t seed = 0)
+	: dim(dim)
+	, seed(seed)
+	{}
+
+	std::size_t dimension() const noexcept { return dim; }
+
+	Vector<S> operator()(std::size_t i) const
+	{
+		Vector<S> res(dim);
+		std::uint64_t state = SplitMix(seed ^ SplitMix(i));
+		for (std::size_t d = 0; d < dim; d++)
+		{
+			state = SplitMix(state);
+			res[d] = static_cast<S>(state >> 11) / static_cast<S>(std::uint64_t(1) << 53);
+		}
+		return res;
+	}
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include "./Vector.hpp"
+
+namespace impl
+{
+	template<typename M>
+	concept Factorizable = requires(M m) {
+		{ std::move(m).Factorize() };
+	};
+
+	template<typename M>
+	struct SharedMatrixState
+	{
+		M m;
+	};
+
+	/**
+	 * factors are computed on first solve and shared by all handle copies
+	 */
+	template<Factorizable M>
+	struct SharedMatrixState<M>
+	{
+		using Factors = decltype(std::declval<M>().Factorize());
+
+		M m;
+		mutable std::once_flag once;
+		mutable std::optional<Factors> factors;
+
+		Factors const& Factorized() const
+		{
+			std::call_once(once, [this] { factors.emplace(M(m).Factorize()); });
+			return *factors;
+		}
+	};
+}
+
+/**
+ * immutable reference-like matrix handle
+ * copying the handle shares matrix data, so it can be passed to gradient/hessian functors for free
+ */
+template<typename M>
+class SharedMatrix
+{
+private:
+	std::shared_ptr<const impl::SharedMatrixState<M>> s;
+
+public:
+	SharedMatrix(M matrix)
+	: s(std::make_shared<const impl::SharedMatrixState<M>>(std::move(matrix)))
+	{}
+
+	M const& operator*() const noexcept { return s->m; }
+	M const* operator->() const noexcept { return &s->m; }
+	operator M const&() const noexcept { return s->m; }
+
+	size_t Dims() const { return s->m.Dims(); }
+	SharedMatrix Transpose() const { return s->m.Transpose(); }
+
+	/**
+	 * matrix is factorized once and every solve reuses factors,
+	 * matrices without separate factorization are copied as solvers work in place
+	 */
+	template<typename T>
+	auto SolveSystem(Vector<T> const& b) const
+	{
+		if constexpr (impl::Factorizable<M>)
+			return s->Factorized().Solve(b);
+		else
+			return M(s->m).SolveSystem(b);
+	}
+};
+
+template<typename M, typename T>
+Vector<T> operator*(SharedMatrix<M> const& l, Vector<T> const& r)
+{
+	return *l * r;
+}
+
+template<typename M, typename R>
+auto operator+(SharedMatrix<M> const& l, R const& r) -> decltype(*l + r)
+{
+	return *l + r;
+}
+
+template<typename M, typename R>
+auto operator-(SharedMatrix<M> const& l, R const& r) -> decltype(*l - r)
+{
+	return *l - r;
+}
@@ -1,9 +1,16 @@
 #pragma once
 
+#include <optional>
+#include <utility>
+
 #include "opt-methods/solvers/BaseApproximator.hpp"
+#include "opt-methods/solvers/Convergence.hpp"
 
-template<typename From, typename To>
-class GradientDescent : public BaseApproximator<From, To, GradientDescent<From, To>>
+/**
+ * @tparam Convergence -- stops earlier than gradient length check if converged
+ */
+template<typename From, typename To, ConvergencePolicy<From, To> Convergence = BuiltinConvergence>
+class GradientDescent : public BaseApproximator<From, To, GradientDescent<From, To, Convergence>>
 {
 private:
 	using BaseT = BaseApproximator<From, To, GradientDescent>;
@@ -17,27 +24,47 @@ public:
 	using V = To;
 
 	Scalar<P> epsilon2;
+	Convergence convergence;
 
-	GradientDescent(decltype(epsilon2) epsilon)
+	GradientDescent(decltype(epsilon2) epsilon, Convergence convergence = {})
 	: epsilon2(epsilon * epsilon)
+	, convergence(std::move(convergence))
 	{}
 
 	template<Function<P, V> F>
-	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	class Stepper
 	{
-		BEGIN_APPROX_COROUTINE(data);
+	private:
+		using Tracker = impl::ConvergenceTracker<P, V, Convergence>;
+		using TrackedF = decltype(std::declval<Tracker&>().track(std::declval<F>()));
+
+		GradientDescent const* approx;
+		Tracker tracker;
+		TrackedF func;
+		decltype(std::declval<TrackedF const&>().grad()) gradf;
+		P x;
+		V fx{};
+		Scalar<P> alpha;
 
-		P x = r.p;
-		auto fx = func(x);
-		Scalar<P> alpha = r.r;
+	public:
+		Stepper(GradientDescent const& approx, F func, PointRegion<P> r)
+		: approx(&approx)
+		, tracker(approx.convergence)
+		, func(tracker.track(std::move(func)))
+		, gradf(this->func.grad())
+		, x(std::move(r.p))
+		, alpha(r.r)
+		{}
 
-		auto gradf = func.grad();
+		void start() { fx = func(x); }
 
-		while (true)
+		bool step(IterationData&)
 		{
 			auto grad = gradf(x);
-			if (Len2(grad) < epsilon2)
-				break;
+			if (Len2(grad) < approx->epsilon2)
+				return false;
+			if (tracker.converged(x, [&]() { return fx; }, [&]() { return grad; }))
+				return false;
 			P y = x;
 			V fy = fx;
 			while (alpha > 0)
@@ -49,8 +76,35 @@ public:
 			}
 			x = y;
 			fx = fy;
-			co_yield {x, 0};
+			return true;
+		}
+
+		PointRegion<P> region() const { return {x, 0}; }
+
+		template<typename Archive>
+		void serialize(Archive& ar)
+		{
+			ar(x, fx, alpha);
+			tracker.serialize(ar);
 		}
+	};
+
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	{
+		return impl::RunStepper<P, V, IterationData>(Stepper<F>(*this, std::move(func), std::move(r)));
+	}
+
+	template<Function<P, V> F>
+	std::optional<PointRegion<P>> minimize(F func, PointRegion<P> r) const
+	{
+		return impl::MinimizeStepper<P, IterationData>(Stepper<F>(*this, std::move(func), std::move(r)));
 	}
-};
 
+	/// operator() with checkpoints, resumes from snapshot if given, yields nothing if snapshot does not match
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> resumable(F func, PointRegion<P> r, util::Checkpointing checkpoints, util::Snapshot const* from) const
+	{
+		return impl::RunStepper<P, V, IterationData>(Stepper<F>(*this, std::move(func), std::move(r)), std::move(checkpoints), from);
+	}
+};
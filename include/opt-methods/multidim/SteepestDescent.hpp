@@ -1,9 +1,14 @@
 #pragma once
 
 #include "opt-methods/solvers/BaseApproximator.hpp"
+#include "opt-methods/solvers/Convergence.hpp"
+#include "opt-methods/solvers/function/LineFunction.hpp"
 
-template<typename From, typename To, Approximator<To, To> OneDimApprox>
-class SteepestDescent : public BaseApproximator<From, To, SteepestDescent<From, To, OneDimApprox>>
+/**
+ * @tparam Convergence -- stops earlier than gradient length check if converged
+ */
+template<typename From, typename To, Approximator<To, To> OneDimApprox, ConvergencePolicy<From, To> Convergence = BuiltinConvergence>
+class SteepestDescent : public BaseApproximator<From, To, SteepestDescent<From, To, OneDimApprox, Convergence>>
 {
 private:
 	using BaseT = BaseApproximator<From, To, SteepestDescent>;
@@ -18,38 +23,46 @@ public:
 	using V = To;
 
 	Scalar<P> epsilon2;
+	Convergence convergence;
 
-	SteepestDescent(decltype(epsilon2) epsilon, OneDimApprox onedim)
+	SteepestDescent(decltype(epsilon2) epsilon, OneDimApprox onedim, Convergence convergence = {})
 	: onedim(std::move(onedim))
 	, epsilon2(epsilon * epsilon)
+	, convergence(std::move(convergence))
 	{}
 
 	template<Function<P, V> F>
-	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
+	ApproxGenerator<P, V> operator()(F func_, PointRegion<P> r) const
 	{
 		BEGIN_APPROX_COROUTINE(data);
 
+		impl::ConvergenceTracker<P, V, Convergence> tracker(convergence);
+		auto func = tracker.track(std::move(func_));
+
 		P x = r.p;
 		auto gradf = func.grad();
+		decltype(auto) lineSearch = impl::ForRun(onedim);
 
 		while (true)
 		{
 			auto grad = gradf(x);
 			if (Len2(grad) < epsilon2) break;
+			if (tracker.converged(x, [&]() { return func(x); }, [&]() { return grad; })) break;
 
-			auto curfunc = [=](Scalar<P> const& lambda) {
-				return func(x - lambda * grad);
-			};
-			auto gen = onedim(curfunc, {0, r.r, bound_tag});
-			while (gen.next())
-				;
-			if (!gen.hasValue())
+			auto res = impl::Minimize<V, V>(lineSearch, LineFunction(func, gradf, x, grad), {0, r.r, bound_tag});
+			if (!res.has_value())
 			{
 				co_yield {x, r.r};
 				break;
 			}
 
-			x -= gen.getValue().p * grad;
+			P next = x - res->p * grad;
+			if (Len2(P(next - x)) == 0) // line search failed or step is lost in rounding, x would not change anymore
+			{
+				co_yield {x, r.r};
+				break;
+			}
+			x = std::move(next);
 			co_yield {x, 0};
 		}
 	}
@@ -26,5 +26,5 @@ namespace impl
 	constexpr inline char DefaultNewtonTraitsName[] = "newton";
 }
 
-template<typename From, typename To>
-using Newton = BaseNewton<From, To, impl::DefaultNewtonTraits, Scalar<From>, impl::DefaultNewtonTraitsName>;
+template<typename From, typename To, ConvergencePolicy<From, To> Convergence = BuiltinConvergence>
+using Newton = BaseNewton<From, To, impl::DefaultNewtonTraits, Scalar<From>, impl::DefaultNewtonTraitsName, Convergence>;
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "opt-methods/solvers/BaseApproximator.hpp"
+#include "opt-methods/solvers/Convergence.hpp"
+#include "opt-methods/solvers/function/function-helper.hpp"
+#include "opt-methods/util/Snapshot.hpp"
 #include <iostream>
 
 template<typename Ff, typename Gg, typename Hh>
@@ -25,17 +28,26 @@ struct NewtonStateBase<From, To, DecomposedFuncTypes<F, FGrad, FHes>>
 	FHes hess;
 	Scalar<From> findRange;
 
+	/// state carried between iterations, use shadowing to extend (call base first)
+	template<typename Archive>
+	void serialize(Archive& ar)
+	{
+		ar(x, p, alpha, findRange);
+	}
+
 	/// use shadowing to override
 	void AdvanceP()
 	{
 		// this->p = this->hess(this->x).Inverse() * this->grad(this->x);
 		this->p = this->hess(this->x).SolveSystem(this->grad(this->x));
+		impl::Count(&EvaluationCounters::linearSolves);
 	}
 
 	/// use shadowing to override
 	void FindAlpha()
 	{
-		while (this->func(this->x) < this->func(this->x - this->p * this->alpha))
+		auto fx = this->func(this->x);
+		while (fx < this->func(this->x - this->p * this->alpha))
 			this->alpha /= 2;
 	}
 };
@@ -49,25 +61,45 @@ concept NewtonStateTraits = requires(Initializer const& init) {
 		{ st.AdvanceP() };
 		{ st.FindAlpha() };
 		{ st.Quits() } -> std::same_as<bool>;
+		requires util::Serializable<typename This::NewtonState>;
 	};
 };
 
+/**
+ * placeholder for functions without hessian, used by matrix-free methods
+ */
+struct NoHessian
+{};
+
 namespace impl
 {
+	auto GetHessian(auto const& func)
+	{
+		if constexpr (HasHessian<std::decay_t<decltype(func)>>)
+			return func.hessian();
+		else
+			return NoHessian{};
+	}
+
 	auto DecomposeFuncTypes(auto func)
 	{
 		return DecomposedFuncTypes<std::decay_t<decltype(func)>,
 				std::decay_t<decltype(func.grad())>,
-				std::decay_t<decltype(func.hessian())>>{};
+				std::decay_t<decltype(GetHessian(func))>>{};
 	}
 }
 
-template<typename From, typename To, template<typename...> typename traits, typename Initializer, char const* nname>
-class BaseNewton : public BaseApproximator<From, To, BaseNewton<From, To, traits, Initializer, nname>>
+/**
+ * @tparam Convergence -- stops earlier than Quits of state if converged
+ */
+template<typename From, typename To, template<typename...> typename traits, typename Initializer, char const* nname,
+         ConvergencePolicy<From, To> Convergence = BuiltinConvergence>
+class BaseNewton : public BaseApproximator<From, To, BaseNewton<From, To, traits, Initializer, nname, Convergence>>
 {
 private:
 	using BaseT = BaseApproximator<From, To, BaseNewton>;
 	Initializer initializer;
+	Convergence convergence;
 
 public:
 	struct IterationData : BaseT::IterationData
@@ -82,30 +114,61 @@ public:
 	using P = From;
 	using V = To;
 
-	BaseNewton(Initializer initializer)
+	BaseNewton(Initializer initializer, Convergence convergence = {})
 	: initializer(std::move(initializer))
+	, convergence(std::move(convergence))
 	{}
 
 	template<Function<P, V> F>
 	ApproxGenerator<P, V> operator()(F func, PointRegion<P> r) const
 		requires NewtonStateTraits<traits<From, To, decltype(impl::DecomposeFuncTypes(func))>, From, To, decltype(impl::DecomposeFuncTypes(func)), Initializer>
+	{
+		return resumable(std::move(func), std::move(r), {}, nullptr);
+	}
+
+	/**
+	 * @param checkpoints -- snapshot is taken after iteration is made and before it is yielded
+	 * @param from -- continue after iteration recorded in snapshot, r must be the same as in interrupted run,
+	 * nothing is yielded if snapshot does not match (see RestoreSnapshot)
+	 */
+	template<Function<P, V> F>
+	ApproxGenerator<P, V> resumable(F func_, PointRegion<P> r, util::Checkpointing checkpoints, util::Snapshot const* from) const
+		requires NewtonStateTraits<traits<From, To, decltype(impl::DecomposeFuncTypes(func_))>, From, To, decltype(impl::DecomposeFuncTypes(func_)), Initializer>
 	{
 		BEGIN_APPROX_COROUTINE(data);
 
+		impl::ConvergenceTracker<P, V, Convergence> tracker(convergence);
+		auto func = tracker.track(std::move(func_));
+
 		typename traits<From, To, decltype(impl::DecomposeFuncTypes(func))>::NewtonState
-			state{r.p, {}, r.r, func, func.grad(), func.hessian(), r.r};
+			state{r.p, {}, r.r, func, func.grad(), impl::GetHessian(func), r.r};
 
 		state.Initialize(static_cast<Initializer const&>(initializer)); // ensure not changed
 
+		auto converged = [&]() {
+			return state.Quits() || tracker.converged(state.x, [&]() { return state.func(state.x); }, [&]() { return state.grad(state.x); });
+		};
+
+		std::size_t iteration = 0;
+		if (from != nullptr)
+		{
+			if (!util::RestoreSnapshot(*from, util::Dimension(r.p), state, tracker))
+				co_return;
+			iteration = from->iteration;
+			if (converged())
+				co_return;
+		}
+
 		do
 		{
 			state.AdvanceP();
 			state.FindAlpha();
 			state.x -= state.p * state.alpha;
 
+			if (checkpoints.due(++iteration))
+				checkpoints.save(util::TakeSnapshot(iteration, util::Dimension(r.p), state, tracker));
 			std::tie(data->x, data->p, data->alpha) = std::make_tuple(state.x, state.p, state.alpha * Len(state.p));
 			co_yield {state.x, 0};
-		} while (!state.Quits());
+		} while (!converged());
 	}
-};
-
+};
\ No newline at end of file
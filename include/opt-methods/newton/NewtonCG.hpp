@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+
+#include "./NewtonBase.hpp"
+#include "opt-methods/math/HessVec.hpp"
+#include "opt-methods/math/def.hpp"
+
+namespace impl
+{
+	/**
+	 * truncated newton: system H p = grad is solved inexactly with conjugate gradients
+	 * using only hessian-vector products, tolerance is chosen by Eisenstat-Walker forcing sequence
+	 */
+	template<typename From, typename To, typename FDec>
+	struct NewtonCGTraits
+	{
+		struct NewtonState : NewtonStateBase<From, To, FDec>
+		{
+			using S = Scalar<From>;
+
+			static constexpr S etaMax = 0.9, gamma = 0.9;
+
+			S epsilon2;
+			S eta;
+			S lastGradLen;
+			bool isFirst;
+
+			void Initialize(S eps) noexcept
+			{
+				this->epsilon2 = eps * eps;
+				eta = S(0.5);
+				isFirst = true;
+			}
+
+			template<typename Archive>
+			void serialize(Archive& ar)
+			{
+				NewtonStateBase<From, To, FDec>::serialize(ar);
+				ar(eta, lastGradLen, isFirst);
+			}
+
+			void UpdateForcingTerm(S gradLen)
+			{
+				using std::min;
+				using std::max;
+				if (isFirst)
+					isFirst = false;
+				else
+				{
+					// choice 2 with safeguard against too fast decrease
+					S next = gamma * square(gradLen / lastGradLen), safe = gamma * eta * eta;
+					if (safe > S(0.1))
+						next = max(next, safe);
+					eta = min(next, etaMax);
+				}
+				lastGradLen = gradLen;
+			}
+
+			void AdvanceP()
+			{
+				auto g = this->grad(this->x);
+				auto gLen = Len(g);
+				UpdateForcingTerm(gLen);
+
+				From p(S(0), g.size()), r = g, d = r;
+				S rr = Len2(r), tol2 = square(eta * gLen);
+				for (std::size_t i = 0; i < g.size() && rr > tol2; i++)
+				{
+					From hd = HessVec(this->func, this->grad, this->x, d, g);
+					S dhd = Dot(d, hd);
+					if (dhd <= 0)
+					{
+						// negative curvature: keep what is found, fall back to gradient on first step
+						if (i == 0)
+							p = g;
+						break;
+					}
+					S a = rr / dhd;
+					p += a * d;
+					r -= a * hd;
+					S nextRr = Len2(r);
+					d = r + (nextRr / rr) * d;
+					rr = nextRr;
+				}
+				this->p = std::move(p);
+				impl::Count(&EvaluationCounters::linearSolves); // inexact, but still one system
+			}
+
+			void FindAlpha()
+			{
+				this->alpha = 1;
+				NewtonStateBase<From, To, FDec>::FindAlpha();
+			}
+
+			bool Quits()
+			{
+				return Len2(this->p) * this->alpha * this->alpha <= epsilon2;
+			}
+		};
+	};
+
+	constexpr inline char NewtonCGTraitsName[] = "newton cg";
+}
+
+template<typename From, typename To, ConvergencePolicy<From, To> Convergence = BuiltinConvergence>
+using NewtonCG = BaseNewton<From, To, impl::NewtonCGTraits, Scalar<From>, impl::NewtonCGTraitsName, Convergence>;
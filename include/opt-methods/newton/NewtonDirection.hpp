@@ -12,6 +12,13 @@ namespace impl
 			using BaseT = NewtonOnedimTraits<From, To, OneDimApprox, FDec>::NewtonState;
 			bool isFirst;
 
+			template<typename Archive>
+			void serialize(Archive& ar)
+			{
+				BaseT::serialize(ar);
+				ar(isFirst);
+			}
+
 			void AdvanceP()
 			{
 				auto g = this->grad(this->x);
@@ -47,5 +54,5 @@ namespace impl
 }
 
 
-template<typename From, typename To, Approximator<To, To> OneDimApprox>
-using NewtonDirection = BaseNewton<From, To, impl::NewtonDirectionTraitsBound<OneDimApprox>::template type, std::tuple<Scalar<From>, OneDimApprox>, impl::NewtonDirectionTraitsName>;
+template<typename From, typename To, Approximator<To, To> OneDimApprox, ConvergencePolicy<From, To> Convergence = BuiltinConvergence>
+using NewtonDirection = BaseNewton<From, To, impl::NewtonDirectionTraitsBound<OneDimApprox>::template type, std::tuple<Scalar<From>, OneDimApprox>, impl::NewtonDirectionTraitsName, Convergence>;
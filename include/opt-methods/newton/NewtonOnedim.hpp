@@ -1,6 +1,9 @@
 #pragma once
 
+#include <optional>
+
 #include "./NewtonBase.hpp"
+#include "opt-methods/solvers/function/LineFunction.hpp"
 
 namespace impl
 {
@@ -12,12 +15,22 @@ namespace impl
 			Scalar<From> epsilon2;
 			OneDimApprox const* approx;
 			bool quits;
+			std::optional<OneDimApprox> runApprox; // copy with fresh state, see impl::ForRun
+
+			/// line search of this run
+			void UseApprox(OneDimApprox const& oda) noexcept
+			{
+				if constexpr (impl::HasRunState<OneDimApprox>)
+					this->approx = &runApprox.emplace(oda.forRun());
+				else
+					this->approx = &oda;
+			}
 
 			void Initialize(Scalar<From> const& eps, OneDimApprox const& oda) noexcept
 			{
 				quits = false;
 				this->epsilon2 = eps * eps;
-				this->approx = &oda;
+				UseApprox(oda);
 			}
 
 			void Initialize(std::tuple<Scalar<From>, OneDimApprox> const& init) noexcept
@@ -25,17 +38,21 @@ namespace impl
 				Initialize(std::get<0>(init), std::get<1>(init));
 			}
 
+			template<typename Archive>
+			void serialize(Archive& ar)
+			{
+				NewtonStateBase<From, To, FDec>::serialize(ar);
+				ar(quits);
+			}
+
 			void FindAlpha()
 			{
-				auto curfunc = [this](double a) {
-					return this->func(this->x - a * this->p);
-				};
-				auto gen = (*approx)(curfunc, {0, this->findRange, bound_tag});
-				while (gen.next())
-					;
-				if (!gen.hasValue())
+				auto res = impl::Minimize<To, To>(*approx, LineFunction(this->func, this->grad, this->x, this->p),
+				                                  {0, this->findRange, bound_tag});
+				if (res.has_value())
+					this->alpha = res->p;
+				else
 					quits = true;
-				this->alpha = gen.getValue().p;
 			}
 
 			bool Quits()
@@ -55,5 +72,5 @@ namespace impl
 	};
 }
 
-template<typename From, typename To, Approximator<To, To> OneDimApprox>
-using NewtonOnedim = BaseNewton<From, To, impl::NewtonOnedimTraitsBound<OneDimApprox>::template type, std::tuple<Scalar<From>, OneDimApprox>, impl::NewtonOnedimTraitsName>;
+template<typename From, typename To, Approximator<To, To> OneDimApprox, ConvergencePolicy<From, To> Convergence = BuiltinConvergence>
+using NewtonOnedim = BaseNewton<From, To, impl::NewtonOnedimTraitsBound<OneDimApprox>::template type, std::tuple<Scalar<From>, OneDimApprox>, impl::NewtonOnedimTraitsName, Convergence>;
@@ -3,3 +3,4 @@
 #include "./Newton.hpp"
 #include "./NewtonOnedim.hpp"
 #include "./NewtonDirection.hpp"
+#include "./NewtonCG.hpp"
@@ -25,7 +25,7 @@ namespace impl
 				BaseT::Initialize(std::get<0>(init));
 				this->quits = false;
 				this->epsilon2 = std::get<0>(init);
-				this->approx = &std::get<1>(init);
+				this->UseApprox(std::get<1>(init));
 			}
 
 			void CalcG()
@@ -56,6 +56,6 @@ namespace impl
 	};
 }
 
-template<typename From, typename To, Approximator<To, To> OneDimApprox>
+template<typename From, typename To, Approximator<To, To> OneDimApprox, ConvergencePolicy<From, To> Convergence = BuiltinConvergence>
 using QuasiNewtonPowell = BaseNewton<From, To, impl::PowellNewtonTraitsBound<OneDimApprox>::template type,
-	                                   std::tuple<Scalar<From>, OneDimApprox>, impl::PowellNewtonTraitsName>;
+	                                   std::tuple<Scalar<From>, OneDimApprox>, impl::PowellNewtonTraitsName, Convergence>;
@@ -30,6 +30,14 @@ namespace impl
 				isFirst = true;
 			}
 
+			/// dGrad and dx are recomputed before use
+			template<typename Archive>
+			void serialize(Archive& ar)
+			{
+				BaseT::serialize(ar);
+				ar(G, curGrad, lastGrad, lastX, isFirst);
+			}
+
 			/// use shadowing to override
 			void CalcG()
 			{}
@@ -5,13 +5,19 @@
 #include <utility>
 #include <complex>
 #include <tuple>
+#include <optional>
 #include <cassert>
+#include <cstddef>
+#include <new>
 
 #include <QtCharts/QChart>
 #include <QtCharts/QScatterSeries>
 
 #include "opt-methods/math/PointRegion.hpp"
 #include "opt-methods/coroutines/Generator.hpp"
+#include "opt-methods/coroutines/FramePool.hpp"
+#include "opt-methods/coroutines/Evaluation.hpp"
+#include "./Counters.hpp"
 
 template<typename Point, typename Value>
 struct PointAndValue
@@ -77,31 +83,78 @@ struct DummyFunc
 
 template<typename P, typename V>
 struct BaseIterationData
-{};
+{
+	EvaluationCounters counters; // filled by solvers with counting policy
+};
+
+namespace impl
+{
+	/**
+	 * statically captured operations on concrete iteration data type
+	 */
+	template<typename P, typename V>
+	struct IterationDataType
+	{
+		std::size_t size;
+		std::size_t align;
+		/// copy-constructs src (of described type) at dst
+		BaseIterationData<P, V>* (*copy)(void* dst, BaseIterationData<P, V> const& src);
+		void (*destroy)(BaseIterationData<P, V>* data) noexcept;
+	};
+
+	template<typename P, typename V, std::derived_from<BaseIterationData<P, V>> IterationData>
+	inline constexpr IterationDataType<P, V> iterationDataTypeOf{
+		sizeof(IterationData),
+		alignof(IterationData),
+		[](void* dst, BaseIterationData<P, V> const& src) -> BaseIterationData<P, V>* {
+			return ::new (dst) IterationData(static_cast<IterationData const&>(src));
+		},
+		[](BaseIterationData<P, V>* data) noexcept { static_cast<IterationData*>(data)->~IterationData(); },
+	};
+
+	/**
+	 * first yield of approximator coroutine, data lives in coroutine frame
+	 */
+	template<typename IterationData>
+	struct IterationDataRef
+	{
+		IterationData* data;
+	};
+}
 
 /** coroutines promise for approximators
+ * frames are recycled through thread-local pool, inner line searches are created on every outer iteration
  */
 template<typename P, typename V>
-struct ApproxPromise : Promise<PointRegion<P>, ApproxPromise<P, V>>
+struct ApproxPromise : Promise<PointRegion<P>, ApproxPromise<P, V>>, util::PooledFrame
 {
 	using Super = Promise<PointRegion<P>, ApproxPromise<P, V>>;
 
-	std::shared_ptr<BaseIterationData<P, V>> data{};
-	std::function<std::shared_ptr<BaseIterationData<P, V>>(BaseIterationData<P, V> *)> copier;
+	BaseIterationData<P, V>* data = nullptr;
+	impl::IterationDataType<P, V> const* dataType = nullptr;
+	std::shared_ptr<impl::EvaluationStateBase> awaiting; // set when suspended on co_await of unfinished evaluation
 
 	std::suspend_never initial_suspend() noexcept { return {}; } // skip first yield resulting in data ptr
 
+	/**
+	 * evaluations are the only awaitables allowed
+	 */
+	using Super::await_transform;
+	template<typename T>
+	Evaluation<T>&& await_transform(Evaluation<T>&& e) noexcept { return std::move(e); }
+	template<typename T>
+	Evaluation<T>& await_transform(Evaluation<T>& e) noexcept { return e; }
+
 	using Super::yield_value;
 	/**
 	 * data setter
 	 */
 	template<std::derived_from<BaseIterationData<P, V>> IterationData>
-	std::suspend_always yield_value(std::unique_ptr<IterationData> data)
+	std::suspend_always yield_value(impl::IterationDataRef<IterationData> ref) noexcept
 	{
-		this->data = std::move(data);
-		copier     = [](BaseIterationData<P, V>* data) -> std::shared_ptr<BaseIterationData<P, V>> {
-			return std::make_shared<IterationData>(static_cast<IterationData &>(*data));
-		};
+		static_assert(alignof(IterationData) <= alignof(std::max_align_t), "copies of iteration data are placed in memory aligned for max_align_t");
+		data     = ref.data;
+		dataType = &impl::iterationDataTypeOf<P, V, IterationData>;
 		return {};
 	}
 
@@ -115,12 +168,12 @@ struct ApproxPromise : Promise<PointRegion<P>, ApproxPromise<P, V>>
 	}
 
 	/**
-	 * data copy getter
+	 * data type getter, to copy data without knowing approximator
 	 */
-	std::shared_ptr<BaseIterationData<P, V>> getIterationDataCopy() const
+	impl::IterationDataType<P, V> const& getIterationDataType() const noexcept
 	{
-		assert(data != nullptr);
-		return copier(data.get());
+		assert(dataType != nullptr);
+		return *dataType;
 	}
 };
 
@@ -140,15 +193,54 @@ public:
 	ApproxGenerator& operator=(ApproxGenerator&& s) = default;
 	ApproxGenerator& operator=(const ApproxGenerator& s) = delete;
 
+	enum class Step
+	{
+		Yielded,
+		Awaiting, // evaluation is in progress, see awaiting()
+		Done,
+	};
+
+	/**
+	 * resumes without blocking, for schedulers
+	 */
+	Step resume()
+	{
+		assert(!this->handle.done());
+		this->handle.promise().awaiting.reset();
+		this->handle.resume();
+		if (this->handle.done())
+			return Step::Done;
+		return this->handle.promise().awaiting != nullptr ? Step::Awaiting : Step::Yielded;
+	}
+
+	/**
+	 * evaluation coroutine is suspended on
+	 */
+	std::shared_ptr<impl::EvaluationStateBase> const& awaiting() const noexcept { return this->handle.promise().awaiting; }
+
+	/**
+	 * resumes until next yield, waiting for evaluations in current thread
+	 */
+	bool next()
+	{
+		auto step = resume();
+		while (step == Step::Awaiting)
+		{
+			awaiting()->wait();
+			step = resume();
+		}
+		return step == Step::Yielded;
+	}
+
 	/**
 	 * data getter
 	 */
 	BaseIterationData<P, V> const& getIterationData() const noexcept { return this->handle.promise().getIterationData(); }
 
 	/**
-	 * data copy getter
+	 * data type getter
 	 */
-	std::shared_ptr<BaseIterationData<P, V>> getIterationDataCopy() const { return this->handle.promise().getIterationDataCopy(); }
+	impl::IterationDataType<P, V> const& getIterationDataType() const noexcept { return this->handle.promise().getIterationDataType(); }
 };
 
 /**
@@ -215,3 +307,58 @@ concept Approximator = requires(T const& t, DummyFunc<P, V> &&func, PointRegion<
 	{ t(func, bounds) } -> std::same_as<ApproxGenerator<P, V>>;
 };
 
+/**
+ * approximator which also can run to the end without coroutine,
+ * minimize returns last region or none if approximator would not yield
+ */
+template<typename T, typename P, typename V>
+concept DirectApproximator = Approximator<T, P, V> && requires(T const& t, DummyFunc<P, V>&& func, PointRegion<P> bounds) {
+	{ t.minimize(func, bounds) } -> std::convertible_to<std::optional<PointRegion<P>>>;
+};
+
+namespace impl
+{
+	/**
+	 * runs approximator to the end, without coroutine when possible, iterations are counted as inner ones
+	 * @return last yielded region, if any
+	 */
+	template<typename P, typename V, Approximator<P, V> A, Function<P, V> F>
+	std::optional<PointRegion<P>> Minimize(A const& approx, F func, PointRegion<P> r)
+	{
+		if constexpr (DirectApproximator<A, P, V>)
+			return approx.minimize(std::move(func), r);
+		else
+		{
+			// yielded region lives in coroutine frame only until next resumption, so it is copied every iteration
+			std::optional<PointRegion<P>> last;
+			auto gen = approx(std::move(func), r);
+			while (gen.next())
+			{
+				last = gen.getValue();
+				Count(&EvaluationCounters::innerIterations);
+			}
+			return last;
+		}
+	}
+
+	/// approximator keeping state between searches of one outer run, forRun() gives copy with fresh state
+	template<typename A>
+	concept HasRunState = requires(A const& a) {
+		{ a.forRun() } -> std::same_as<A>;
+	};
+
+	/**
+	 * approximator to use during one outer run, methods doing many inner searches take it once per run,
+	 * so state of one run is not seen by others
+	 * @return fresh copy if approximator has run state, reference to it otherwise
+	 */
+	template<typename A>
+	decltype(auto) ForRun(A const& approx)
+	{
+		if constexpr (HasRunState<A>)
+			return approx.forRun();
+		else
+			return approx;
+	}
+}
+
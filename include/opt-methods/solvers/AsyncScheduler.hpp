@@ -0,0 +1,144 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "./Approximator.hpp"
+#include "./function/function-helper.hpp"
+#include "opt-methods/util/ThreadPool.hpp"
+
+/**
+ * function evaluated on thread pool, approximators which co_await Evaluate() suspend instead of blocking
+ * plain calls and derivatives stay synchronous
+ */
+template<typename P, typename V, typename F>
+class AsyncFunction
+{
+private:
+	std::shared_ptr<F const> func;
+	std::shared_ptr<util::ThreadPool> pool;
+
+public:
+	AsyncFunction(F func, std::shared_ptr<util::ThreadPool> pool)
+	: func(std::make_shared<F const>(std::move(func)))
+	, pool(std::move(pool))
+	{}
+
+	V operator()(P const& x) const { return (*func)(x); }
+
+	Evaluation<V> evaluate(P const& x) const
+	{
+		auto state = std::make_shared<impl::EvaluationState<V>>();
+		pool->post([state, func = func, x]() {
+			try
+			{
+				state->complete((*func)(x));
+			}
+			catch (...)
+			{
+				state->fail(std::current_exception());
+			}
+		});
+		return Evaluation<V>(std::move(state));
+	}
+
+	auto grad() const requires HasGrad<F>
+	{
+		return func->grad();
+	}
+};
+
+/**
+ * interleaves many approximator coroutines on few threads:
+ * coroutine suspended on evaluation is put aside and rescheduled when evaluation completes
+ */
+template<typename P, typename V>
+class AsyncScheduler
+{
+public:
+	using OnYield = std::function<void(PointRegion<P> const&)>;
+	using OnDone = std::function<void()>;
+
+private:
+	struct Task
+	{
+		ApproxGenerator<P, V> gen;
+		OnYield onYield;
+		OnDone onDone;
+	};
+
+	std::mutex m;
+	std::condition_variable cv;
+	std::deque<std::shared_ptr<Task>> ready;
+	std::size_t alive = 0; // added and not finished
+
+	void schedule(std::shared_ptr<Task> task)
+	{
+		{
+			std::unique_lock lock(m);
+			ready.push_back(std::move(task));
+		}
+		cv.notify_one();
+	}
+
+public:
+	/**
+	 * may be called while run() is in progress, also from callbacks
+	 */
+	void add(ApproxGenerator<P, V> gen, OnYield onYield = {}, OnDone onDone = {})
+	{
+		{
+			std::unique_lock lock(m);
+			alive++;
+		}
+		schedule(std::make_shared<Task>(Task{std::move(gen), std::move(onYield), std::move(onDone)}));
+	}
+
+	/**
+	 * runs coroutines until all of them are done, several threads may call it concurrently
+	 * a coroutine is resumed by one thread at a time, callbacks are called from resuming thread
+	 */
+	void run()
+	{
+		while (true)
+		{
+			std::shared_ptr<Task> task;
+			{
+				std::unique_lock lock(m);
+				cv.wait(lock, [this]() { return !ready.empty() || alive == 0; });
+				if (ready.empty())
+					return;
+				task = std::move(ready.front());
+				ready.pop_front();
+			}
+
+			using Step = typename ApproxGenerator<P, V>::Step;
+			switch (task->gen.resume())
+			{
+			case Step::Yielded:
+				if (task->onYield)
+					task->onYield(task->gen.getValue());
+				schedule(std::move(task));
+				break;
+			case Step::Awaiting:
+			{
+				auto state = task->gen.awaiting();
+				state->then([this, task = std::move(task)]() mutable { schedule(std::move(task)); });
+				break;
+			}
+			case Step::Done:
+				if (task->onDone)
+					task->onDone();
+				{
+					std::unique_lock lock(m);
+					alive--;
+				}
+				cv.notify_all();
+				break;
+			}
+		}
+	}
+};
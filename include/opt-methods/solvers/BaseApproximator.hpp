@@ -1,9 +1,11 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <type_traits>
 
 #include "./Approximator.hpp"
+#include "opt-methods/util/Snapshot.hpp"
 
 namespace QtCharts
 {
@@ -40,18 +42,86 @@ public:
 	}
 
 	void draw(BoundsWithValues<P, V> r, [[maybe_unused]] IterationData const& data, QtCharts::QChart& chart) const;
+};
+
+/**
+ * declares iteration data in coroutine frame and passes it to promise
+ */
+#define BEGIN_APPROX_COROUTINE(data)                  \
+	IterationData data##Storage{};                       \
+	[[maybe_unused]] IterationData *data = &data##Storage; \
+	co_yield impl::IterationDataRef<IterationData>{data}
+
+namespace impl
+{
+	/**
+	 * approximator body written once as stepper serves both execution modes:
+	 * start() makes initial evaluations, step(data) makes one iteration and returns false when done,
+	 * region() is bounds after last step
+	 */
+	template<typename S, typename P, typename IterationData>
+	concept ApproxStepper = requires(S& s, IterationData& data) {
+		s.start();
+		{ s.step(data) } -> std::convertible_to<bool>;
+		{ s.region() } -> std::convertible_to<PointRegion<P>>;
+	};
+
+	/**
+	 * coroutine yielding after each step, for observers and drawing
+	 */
+	template<typename P, typename V, typename IterationData, ApproxStepper<P, IterationData> Stepper>
+	ApproxGenerator<P, V> RunStepper(Stepper st)
+	{
+		BEGIN_APPROX_COROUTINE(data);
+
+		st.start();
+		while (st.step(*data))
+			co_yield st.region();
+	}
 
-	// template so that can postpone getting IterationData from CRTP child
-	auto preproc() const
+	/**
+	 * same as above, stepper state is saved between steps and can be restored instead of start(),
+	 * nothing is yielded if snapshot does not match stepper
+	 */
+	template<typename P, typename V, typename IterationData, ApproxStepper<P, IterationData> Stepper>
+		requires util::Serializable<Stepper>
+	ApproxGenerator<P, V> RunStepper(Stepper st, util::Checkpointing checkpoints, util::Snapshot const* from)
 	{
-		return std::make_unique<typename CRTP_Child::IterationData>();
+		BEGIN_APPROX_COROUTINE(data);
+
+		auto dimension = util::Dimension(st.region().p);
+		std::size_t iteration = 0;
+		if (from != nullptr)
+		{
+			if (!util::RestoreSnapshot(*from, dimension, st))
+				co_return;
+			iteration = from->iteration;
+		}
+		else
+			st.start();
+		while (st.step(*data))
+		{
+			if (checkpoints.due(++iteration))
+				checkpoints.save(util::TakeSnapshot(iteration, dimension, st));
+			co_yield st.region();
+		}
 	}
-};
 
-#define BEGIN_APPROX_COROUTINE(data)						\
-	[[maybe_unused]] IterationData *data;					\
-	{																							\
-		std::unique_ptr u_data = this->preproc();		\
-		data = u_data.get();												\
-		co_yield std::move(u_data);									\
+	/**
+	 * tight loop without suspension, see DirectApproximator
+	 * @return bounds after last step, none if there were no steps
+	 */
+	template<typename P, typename IterationData, ApproxStepper<P, IterationData> Stepper>
+	std::optional<PointRegion<P>> MinimizeStepper(Stepper st)
+	{
+		IterationData data{};
+		st.start();
+		std::size_t steps = 0;
+		while (st.step(data))
+			steps++;
+		Count(&EvaluationCounters::innerIterations, steps);
+		if (steps == 0)
+			return {};
+		return st.region();
 	}
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <optional>
+
+#include "./Erased.hpp"
+#include "./function/CountingFunction.hpp"
+
+/**
+ * limits checked between iterations of approximator,
+ * so the last iteration may exceed evaluation limits
+ */
+struct Budget
+{
+	static constexpr std::size_t unlimited = std::numeric_limits<std::size_t>::max();
+
+	std::size_t evaluations = unlimited; // function values
+	std::size_t gradients = unlimited;
+	std::size_t hessians = unlimited; // hessians and hessian-vector products
+	std::size_t iterations = unlimited;
+	std::optional<std::chrono::steady_clock::time_point> deadline;
+
+	static Budget Within(std::chrono::steady_clock::duration d)
+	{
+		Budget res;
+		res.deadline = std::chrono::steady_clock::now() + d;
+		return res;
+	}
+};
+
+enum class TerminationReason
+{
+	Finished, // approximator stopped by itself
+	Evaluations,
+	Gradients,
+	Hessians,
+	Iterations,
+	Deadline,
+};
+
+inline char const* ToString(TerminationReason r) noexcept
+{
+	switch (r)
+	{
+	case TerminationReason::Finished:    return "finished";
+	case TerminationReason::Evaluations: return "evaluation budget";
+	case TerminationReason::Gradients:   return "gradient budget";
+	case TerminationReason::Hessians:    return "hessian budget";
+	case TerminationReason::Iterations:  return "iteration budget";
+	case TerminationReason::Deadline:    return "deadline";
+	}
+	return "unknown";
+}
+
+template<typename P, typename V>
+struct BudgetedResult
+{
+	PointRegion<P> region;                  // last yielded region
+	std::optional<PointAndValue<P, V>> best; // best evaluated point
+	TerminationReason reason;
+	std::size_t iterations = 0, evaluations = 0, gradients = 0, hessians = 0;
+};
+
+namespace impl
+{
+	/**
+	 * counters and best point of one run, written from evaluating threads,
+	 * read between iterations when no evaluation is running
+	 */
+	template<typename P, typename V>
+	struct EvaluationLog
+	{
+		EvaluationCounters counters;
+		std::optional<PointAndValue<P, V>> best;
+		std::mutex mutex; // guards best
+
+		void offer(P const& x, V const& v)
+		{
+			std::lock_guard lock(mutex);
+			if (!best.has_value() || v < best->v)
+				best.emplace(x, v);
+		}
+	};
+
+	/**
+	 * counting function remembering best point, may be called from several threads
+	 */
+	template<typename P, typename V, typename F>
+	class CountingProxy : public CountingFunction<P, V, F>
+	{
+	private:
+		using BaseT = CountingFunction<P, V, F>;
+
+		EvaluationLog<P, V>* log;
+
+	public:
+		CountingProxy(F func, EvaluationLog<P, V>& log)
+		: BaseT(std::move(func), log.counters)
+		, log(&log)
+		{}
+
+		V operator()(P const& x) const
+		{
+			V res = BaseT::operator()(x);
+			log->offer(x, res);
+			return res;
+		}
+	};
+}
+
+/**
+ * runs approximator until it stops or budget is exhausted
+ */
+template<typename P, typename V, Approximator<P, V> Approx>
+class BudgetedSolver
+{
+public:
+	using ApproxT = Approx;
+
+	Approx approximator;
+
+	template<typename ... Args>
+		requires std::is_constructible_v<Approx, Args&&...>
+	BudgetedSolver(Args&& ... args)
+	: approximator(std::forward<Args>(args)...)
+	{}
+
+	/**
+	 * @param onIteration -- called with each yielded region
+	 */
+	template<Function<P, V> F, typename Callback = void (*)(PointRegion<P> const&)>
+	BudgetedResult<P, V> solve(F func, PointRegion<P> region, Budget const& budget, Callback&& onIteration = [](PointRegion<P> const&) {}) const
+	{
+		impl::EvaluationLog<P, V> log;
+		BudgetedResult<P, V> res{region, {}, TerminationReason::Finished};
+
+		auto exhausted = [&]() -> std::optional<TerminationReason> {
+			if (log.counters.evaluations >= budget.evaluations)
+				return TerminationReason::Evaluations;
+			if (log.counters.gradients >= budget.gradients)
+				return TerminationReason::Gradients;
+			if (log.counters.hessians >= budget.hessians)
+				return TerminationReason::Hessians;
+			if (res.iterations >= budget.iterations)
+				return TerminationReason::Iterations;
+			if (budget.deadline.has_value() && std::chrono::steady_clock::now() >= *budget.deadline)
+				return TerminationReason::Deadline;
+			return {};
+		};
+
+		auto gen = approximator(impl::CountingProxy<P, V, F>(std::move(func), log), region);
+		while (true)
+		{
+			if (auto reason = exhausted())
+			{
+				res.reason = *reason;
+				break;
+			}
+			if (!gen.next())
+				break;
+			res.iterations++;
+			res.region = gen.getValue();
+			onIteration(res.region);
+		}
+
+		res.best = std::move(log.best);
+		res.evaluations = log.counters.evaluations;
+		res.gradients = log.counters.gradients;
+		res.hessians = log.counters.hessians;
+		return res;
+	}
+};
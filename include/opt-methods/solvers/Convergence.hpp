@@ -0,0 +1,321 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include "./function/CountingFunction.hpp"
+#include "./function/LastPointFunction.hpp"
+#include "opt-methods/math/Scalar.hpp"
+#include "opt-methods/math/Vector.hpp"
+#include "opt-methods/util/Snapshot.hpp"
+
+/**
+ * quantities each convergence policy declares it uses, tracker computes only union of them
+ */
+struct ConvergenceNeeds
+{
+	bool step = false;        // step and point lengths
+	bool value = false;       // function at current point
+	bool grad = false;        // gradient length at current point
+	bool evaluations = false; // function evaluations made by approximator
+
+	constexpr ConvergenceNeeds operator|(ConvergenceNeeds const& r) const noexcept
+	{
+		return {step || r.step, value || r.value, grad || r.grad, evaluations || r.evaluations};
+	}
+};
+
+/**
+ * values of current iteration shared by all policies, fields not in needs are left zero
+ */
+template<typename P, typename V>
+struct ConvergenceQuantities
+{
+	std::size_t iteration = 0; // number of points checked before this one
+	Scalar<P> step2{};         // Len2(x - previous x)
+	Scalar<P> x2{};            // Len2(x)
+	Scalar<P> grad2{};
+	V value{}, lastValue{};
+	std::size_t evaluations = 0;
+
+	bool hasPrevious() const noexcept { return iteration > 0; }
+};
+
+template<typename T, typename P, typename V>
+concept ConvergencePolicy = requires(T& t, ConvergenceQuantities<P, V> const& q) {
+	{ T::needs } -> std::convertible_to<ConvergenceNeeds>;
+	{ t.converged(q) } -> std::same_as<bool>;
+};
+
+/**
+ * only stopping rule built into approximator, which is also used with any other policy
+ */
+struct BuiltinConvergence
+{
+	static constexpr ConvergenceNeeds needs{};
+
+	template<typename P, typename V>
+	bool converged(ConvergenceQuantities<P, V> const&) const noexcept { return false; }
+};
+
+template<typename S>
+struct GradientNorm
+{
+	static constexpr ConvergenceNeeds needs{.grad = true};
+	S epsilon;
+
+	template<typename P, typename V>
+	bool converged(ConvergenceQuantities<P, V> const& q) const noexcept { return q.grad2 < epsilon * epsilon; }
+};
+
+/**
+ * step is small relative to point, absolute near origin
+ */
+template<typename S>
+struct RelativeStep
+{
+	static constexpr ConvergenceNeeds needs{.step = true};
+	S epsilon;
+
+	template<typename P, typename V>
+	bool converged(ConvergenceQuantities<P, V> const& q) const noexcept
+	{
+		using std::max;
+		return q.hasPrevious() && q.step2 <= epsilon * epsilon * max<Scalar<P>>(q.x2, 1);
+	}
+};
+
+/**
+ * change of value is small relative to value, absolute near zero
+ */
+template<typename S>
+struct RelativeDecrease
+{
+	static constexpr ConvergenceNeeds needs{.value = true};
+	S epsilon;
+
+	template<typename P, typename V>
+	bool converged(ConvergenceQuantities<P, V> const& q) const noexcept
+	{
+		using std::abs;
+		using std::max;
+		return q.hasPrevious() && abs(q.lastValue - q.value) <= epsilon * max<V>(abs(q.value), 1);
+	}
+};
+
+/**
+ * best value did not improve by relative tolerance during window iterations
+ */
+template<typename V>
+struct Stagnation
+{
+	static constexpr ConvergenceNeeds needs{.value = true};
+	std::size_t window;
+	V tolerance;
+
+	V best{};
+	std::size_t since = 0;
+	bool hasBest = false;
+
+	Stagnation(std::size_t window, V tolerance)
+	: window(window)
+	, tolerance(tolerance)
+	{}
+
+	template<typename P>
+	bool converged(ConvergenceQuantities<P, V> const& q) noexcept
+	{
+		using std::abs;
+		using std::max;
+		if (!hasBest || q.value < best - tolerance * max<V>(abs(best), 1))
+		{
+			best = q.value, since = 0, hasBest = true;
+			return false;
+		}
+		return ++since >= window;
+	}
+
+	template<typename Archive>
+	void serialize(Archive& ar)
+	{
+		ar(best, since, hasBest);
+	}
+};
+
+/**
+ * checked once per iteration, so last iteration may exceed limit
+ */
+struct MaxEvaluations
+{
+	static constexpr ConvergenceNeeds needs{.evaluations = true};
+	std::size_t limit;
+
+	template<typename P, typename V>
+	bool converged(ConvergenceQuantities<P, V> const& q) const noexcept { return q.evaluations >= limit; }
+};
+
+namespace impl
+{
+	template<typename Archive, typename... Ps>
+	void SerializePolicies(Archive& ar, std::tuple<Ps...>& policies)
+	{
+		std::apply([&](auto&... p) {
+			([&](auto& policy) {
+				if constexpr (util::Serializable<std::decay_t<decltype(policy)>>)
+					policy.serialize(ar);
+			}(p), ...);
+		}, policies);
+	}
+}
+
+/**
+ * converged when any policy is, every policy sees every iteration
+ */
+template<typename... Ps>
+struct AnyOf
+{
+	static constexpr ConvergenceNeeds needs = (ConvergenceNeeds{} | ... | Ps::needs);
+	std::tuple<Ps...> policies;
+
+	AnyOf(Ps... policies)
+	: policies(std::move(policies)...)
+	{}
+
+	template<typename P, typename V>
+	bool converged(ConvergenceQuantities<P, V> const& q)
+	{
+		return std::apply([&](auto&... p) { return (false | ... | p.converged(q)); }, policies);
+	}
+
+	template<typename Archive>
+	void serialize(Archive& ar) { impl::SerializePolicies(ar, policies); }
+};
+
+/**
+ * converged when all policies are, every policy sees every iteration
+ */
+template<typename... Ps>
+struct AllOf
+{
+	static constexpr ConvergenceNeeds needs = (ConvergenceNeeds{} | ... | Ps::needs);
+	std::tuple<Ps...> policies;
+
+	AllOf(Ps... policies)
+	: policies(std::move(policies)...)
+	{}
+
+	template<typename P, typename V>
+	bool converged(ConvergenceQuantities<P, V> const& q)
+	{
+		return std::apply([&](auto&... p) { return (true & ... & p.converged(q)); }, policies);
+	}
+
+	template<typename Archive>
+	void serialize(Archive& ar) { impl::SerializePolicies(ar, policies); }
+};
+
+namespace impl
+{
+	/**
+	 * computes quantities needed by policy once per iteration and asks it,
+	 * with BuiltinConvergence does nothing
+	 */
+	template<typename P, typename V, ConvergencePolicy<P, V> Policy>
+	class ConvergenceTracker
+	{
+	private:
+		static constexpr ConvergenceNeeds needs = Policy::needs;
+
+		Policy policy;
+		ConvergenceQuantities<P, V> q;
+		P lastX{};
+		std::unique_ptr<EvaluationCounters> counters; // stays in place when tracker is moved
+		std::unique_ptr<LastPointCache<P, V>> cache;
+
+		template<typename F>
+		auto cached(F func)
+		{
+			if constexpr (needs.value || needs.grad)
+				return LastPointFunction<P, V, F>(std::move(func), *cache);
+			else
+				return func;
+		}
+
+	public:
+		static constexpr bool enabled = !std::same_as<Policy, BuiltinConvergence>;
+
+		explicit ConvergenceTracker(Policy policy)
+		: policy(std::move(policy))
+		{
+			if constexpr (needs.evaluations)
+				counters = std::make_unique<EvaluationCounters>();
+			if constexpr (needs.value || needs.grad)
+				cache = std::make_unique<LastPointCache<P, V>>();
+		}
+
+		/**
+		 * function for approximator to use, counts evaluations if policy needs them,
+		 * if policy needs value or gradient, they are cached at last point,
+		 * so checks at point approximator has just evaluated or evaluates next cost nothing
+		 */
+		template<typename F>
+		auto track(F func)
+		{
+			if constexpr (needs.evaluations)
+				return cached(CountingFunction<P, V, F>(std::move(func), *counters));
+			else
+				return cached(std::move(func));
+		}
+
+		/**
+		 * @param value, grad -- called only if policy needs them, pass known values to avoid recomputation
+		 */
+		template<typename Value, typename Grad>
+		bool converged(P const& x, Value&& value, Grad&& grad)
+		{
+			if constexpr (!enabled)
+				return false;
+			else
+			{
+				if constexpr (needs.step)
+				{
+					if (q.hasPrevious())
+						q.step2 = Len2(P(x - lastX));
+					q.x2 = Len2(x);
+					lastX = x;
+				}
+				if constexpr (needs.value)
+					q.lastValue = std::exchange(q.value, static_cast<V>(value()));
+				if constexpr (needs.grad)
+					q.grad2 = Len2(P(grad()));
+				if constexpr (needs.evaluations)
+					q.evaluations = counters->evaluations;
+				bool res = policy.converged(q);
+				q.iteration++;
+				return res;
+			}
+		}
+
+		template<typename Archive>
+		void serialize(Archive& ar)
+		{
+			if constexpr (enabled)
+			{
+				ar(q.iteration, q.value);
+				if constexpr (needs.evaluations)
+					ar(counters->evaluations);
+				if constexpr (needs.step)
+					ar(lastX);
+				if constexpr (needs.value || needs.grad)
+					cache->serialize(ar);
+				if constexpr (util::Serializable<Policy>)
+					policy.serialize(ar);
+			}
+		}
+	};
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+
+/**
+ * work done on one iteration of approximator
+ */
+struct EvaluationCounters
+{
+	std::size_t evaluations = 0; // function values
+	std::size_t gradients = 0;
+	std::size_t hessians = 0;
+	std::size_t linearSolves = 0;
+	std::size_t innerIterations = 0; // iterations of nested one-dimensional approximators
+
+	EvaluationCounters& operator+=(EvaluationCounters const& r) noexcept
+	{
+		evaluations += r.evaluations;
+		gradients += r.gradients;
+		hessians += r.hessians;
+		linearSolves += r.linearSolves;
+		innerIterations += r.innerIterations;
+		return *this;
+	}
+
+	friend EvaluationCounters operator+(EvaluationCounters l, EvaluationCounters const& r) noexcept { return l += r; }
+};
+
+/**
+ * counting policies for solvers
+ */
+struct NoCounting
+{
+	static constexpr bool enabled = false;
+};
+struct CountEvaluations
+{
+	static constexpr bool enabled = true;
+};
+
+template<typename T>
+concept CountingPolicy = requires {
+	{ T::enabled } -> std::convertible_to<bool>;
+};
+
+namespace impl
+{
+	/// counters of iteration being computed on this thread, null if nobody counts
+	inline thread_local EvaluationCounters* activeCounters = nullptr;
+
+	/**
+	 * adds to counter of active iteration, for work not visible through function proxy
+	 */
+	inline void Count(std::size_t EvaluationCounters::*field, std::size_t n = 1) noexcept
+	{
+		if (activeCounters != nullptr)
+			activeCounters->*field += n;
+	}
+
+	/**
+	 * makes counters active for current thread until destruction
+	 */
+	class CountersScope
+	{
+	private:
+		EvaluationCounters* previous;
+
+	public:
+		explicit CountersScope(EvaluationCounters& counters) noexcept
+		: previous(std::exchange(activeCounters, &counters))
+		{}
+
+		CountersScope(CountersScope const&) = delete;
+		CountersScope& operator=(CountersScope const&) = delete;
+
+		~CountersScope() { activeCounters = previous; }
+	};
+
+	/**
+	 * increment safe for functions evaluated on thread pools
+	 */
+	inline void AtomicIncrement(std::size_t& counter) noexcept
+	{
+		std::atomic_ref<std::size_t>(counter).fetch_add(1, std::memory_order_relaxed);
+	}
+}
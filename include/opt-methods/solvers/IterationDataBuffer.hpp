@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "./Approximator.hpp"
+
+/**
+ * log of iteration data copies with regions, elements are pairs of data pointer and region
+ * copies are placed into growing chunks by their statically captured type,
+ * pointers stay valid until clear or destruction, clear keeps memory for next solve
+ * chunks are aligned for max_align_t, over-aligned data is rejected when its type is captured (see ApproxPromise)
+ */
+template<typename P, typename V>
+class IterationDataBuffer
+{
+public:
+	using value_type = std::pair<BaseIterationData<P, V>*, PointRegion<P>>;
+	using const_iterator = typename std::vector<value_type>::const_iterator;
+
+private:
+	struct ChunkDeleter
+	{
+		void operator()(std::byte* ptr) const noexcept { ::operator delete(ptr, std::align_val_t{alignof(std::max_align_t)}); }
+	};
+	using Chunk = std::unique_ptr<std::byte, ChunkDeleter>;
+
+	static constexpr std::size_t minChunk = 4096;
+
+	std::vector<value_type> entries;
+	std::vector<impl::IterationDataType<P, V> const*> types;
+	std::vector<std::pair<Chunk, std::size_t>> chunks; // memory and its size
+	std::size_t chunk = 0, used = 0;                    // current chunk and bytes used in it
+
+	void* place(std::size_t size, std::size_t align)
+	{
+		assert(align <= alignof(std::max_align_t));
+		align = alignof(std::max_align_t);
+		while (true)
+		{
+			if (chunk < chunks.size())
+			{
+				std::size_t offset = (used + align - 1) / align * align;
+				if (offset + size <= chunks[chunk].second)
+				{
+					used = offset + size;
+					return chunks[chunk].first.get() + offset;
+				}
+				if (chunk + 1 < chunks.size())
+				{
+					chunk++, used = 0;
+					continue;
+				}
+			}
+			std::size_t bytes = std::max({minChunk, 2 * size + align, chunks.empty() ? 0 : 2 * chunks.back().second});
+			chunks.emplace_back(Chunk(static_cast<std::byte*>(::operator new(bytes, std::align_val_t{alignof(std::max_align_t)}))), bytes);
+			chunk = chunks.size() - 1, used = 0;
+		}
+	}
+
+public:
+	IterationDataBuffer() = default;
+
+	IterationDataBuffer(IterationDataBuffer&& o) noexcept
+	: entries(std::move(o.entries))
+	, types(std::move(o.types))
+	, chunks(std::move(o.chunks))
+	, chunk(std::exchange(o.chunk, 0))
+	, used(std::exchange(o.used, 0))
+	{
+		o.entries.clear(), o.types.clear(), o.chunks.clear();
+	}
+
+	IterationDataBuffer(IterationDataBuffer const& o)
+	{
+		for (std::size_t i = 0; i < o.size(); i++)
+			emplace(*o.types[i], *o.entries[i].first, o.entries[i].second);
+	}
+
+	IterationDataBuffer& operator=(IterationDataBuffer o) noexcept
+	{
+		clear();
+		entries = std::move(o.entries), types = std::move(o.types), chunks = std::move(o.chunks);
+		chunk = o.chunk, used = o.used;
+		o.entries.clear(), o.types.clear(), o.chunks.clear();
+		return *this;
+	}
+
+	~IterationDataBuffer() { clear(); }
+
+	/**
+	 * copies data of type described by type
+	 */
+	value_type& emplace(impl::IterationDataType<P, V> const& type, BaseIterationData<P, V> const& data, PointRegion<P> region)
+	{
+		void* mem = place(type.size, type.align);
+		entries.emplace_back(type.copy(mem, data), std::move(region));
+		types.push_back(&type);
+		return entries.back();
+	}
+
+	/**
+	 * recorder interface, see IterationRecorder
+	 */
+	void record(ApproxGenerator<P, V> const& gen, PointRegion<P> const& region, EvaluationCounters const& counters)
+	{
+		emplace(gen.getIterationDataType(), gen.getIterationData(), region).first->counters = counters;
+	}
+
+	/**
+	 * @param bytes -- memory for iteration data copies
+	 */
+	void reserve(std::size_t count, std::size_t bytes)
+	{
+		entries.reserve(count);
+		types.reserve(count);
+		if (chunks.empty() && bytes > 0)
+		{
+			chunks.emplace_back(Chunk(static_cast<std::byte*>(::operator new(bytes, std::align_val_t{alignof(std::max_align_t)}))), bytes);
+			chunk = 0, used = 0;
+		}
+	}
+
+	void clear() noexcept
+	{
+		for (std::size_t i = 0; i < entries.size(); i++)
+			types[i]->destroy(entries[i].first);
+		entries.clear();
+		types.clear();
+		chunk = 0, used = 0;
+	}
+
+	std::size_t size() const noexcept { return entries.size(); }
+	bool empty() const noexcept { return entries.empty(); }
+
+	value_type const& operator[](std::size_t i) const noexcept { return entries[i]; }
+	value_type const& back() const noexcept { return entries.back(); }
+
+	const_iterator begin() const noexcept { return entries.begin(); }
+	const_iterator end() const noexcept { return entries.end(); }
+};
@@ -1,18 +1,24 @@
 #pragma once
 
+#include <optional>
+
 #include "./Erased.hpp"
+#include "./Recorders.hpp"
+#include "./function/CountingFunction.hpp"
 
 /**
  * wrapper class to solve with loops
+ * solve methods take any IterationRecorder: SolveData keeps everything, Recorders.hpp has cheaper ones
+ * @tparam Counting -- CountEvaluations fills counters of each iteration data, NoCounting leaves them zero
  */
-template<typename P, typename V, Approximator<P, V> Approx>
+template<typename P, typename V, Approximator<P, V> Approx, CountingPolicy Counting = NoCounting>
 class IterationalSolver
 {
 public:
 	using Bounds = RangeBounds<P>;
 	using BoundsEval = PointRegion<P>;
 
-	using SolveData = std::vector<std::pair<std::shared_ptr<BaseIterationData<P, V>>, PointRegion<P>>>;
+	using SolveData = IterationDataBuffer<P, V>;
 
 	using ApproxT = Approx;
 
@@ -28,29 +34,64 @@ public:
 	= default;
 
 private:
-	template<Function<P, V> F, typename Checker>
-	BoundsEval solveWhile(F&& func, Bounds bounds, Checker&& checker, SolveData& data) const requires
+	template<Function<P, V> F, typename Checker, IterationRecorder<P, V> Recorder>
+	BoundsEval solveWhile(F&& func, Bounds bounds, Checker&& checker, Recorder& data) const requires
 		requires(BoundsEval b, std::size_t iter) {
 			{ checker(b, iter) } -> std::convertible_to<bool>;
 		}
 	{
 		BoundsEval b = {bounds.l, bounds.r, bound_tag};
-		auto gen = approximator(std::forward<F>(func), b);
+		EvaluationCounters current;
+		std::optional<impl::CountersScope> scope;
+		auto gen = [&]() {
+			if constexpr (Counting::enabled)
+			{
+				scope.emplace(current);
+				return approximator(impl::CountingFunction<P, V, std::decay_t<F>>(std::forward<F>(func), current), b);
+			}
+			else
+				return approximator(std::forward<F>(func), b);
+		}();
 		for (std::size_t iterations = 0; gen.next(); iterations++)
 		{
-			data.push_back({gen.getIterationDataCopy(), b});
+			data.record(gen, b, current);
+			current = {};
 			if (!checker(b, iterations)) break;
 			b = gen.getValue();
 		}
+		if constexpr (requires { data.finish(b); })
+			data.finish(b);
 		return b;
 	}
 
 public:
 	/**
-	 * @param iterations -- solve while possible && i=0.. < iterations
+	 * runs to the end without recording, DirectApproximator runs without coroutine
+	 * counting policy is not applied
+	 * @return last region, bounds if approximator made no iterations
 	 */
 	template<Function<P, V> F>
-	BoundsEval solveIteration(F&& func, std::size_t iterations, Bounds bounds, SolveData& data) const
+	BoundsEval solveDirect(F&& func, BoundsEval bounds) const
+	{
+		return impl::Minimize<P, V>(approximator, std::forward<F>(func), bounds).value_or(bounds);
+	}
+
+	/**
+	 * @return sum of counters over all iterations
+	 */
+	static EvaluationCounters total(SolveData const& data) noexcept
+	{
+		EvaluationCounters res;
+		for (auto const& [it, b] : data)
+			res += it->counters;
+		return res;
+	}
+
+	/**
+	 * @param iterations -- solve while possible && i=0.. < iterations
+	 */
+	template<Function<P, V> F, IterationRecorder<P, V> Recorder>
+	BoundsEval solveIteration(F&& func, std::size_t iterations, Bounds bounds, Recorder& data) const
 	{
 		return solveWhile(
 				std::forward<F>(func), std::move(bounds), [&](auto&&, std::size_t iter) { return iter < iterations; }, data);
@@ -59,8 +100,8 @@ public:
 	/**
 	 * @param iterations -- solve while possible && i=0.. < iterations
 	 */
-	template<Function<P, V> F>
-	BoundsEval solveIteration(F&& func, std::size_t iterations, BoundsEval bounds, SolveData& data) const
+	template<Function<P, V> F, IterationRecorder<P, V> Recorder>
+	BoundsEval solveIteration(F&& func, std::size_t iterations, BoundsEval bounds, Recorder& data) const
 	{
 		return solveIteration(func, iterations, Bounds{bounds.p - bounds.r, bounds.p + bounds.r}, data);
 	}
@@ -68,8 +109,8 @@ public:
 	/**
 	 * @param diff -- solve while possible && distance between ends > diff
 	 */
-	template<Function<P, V> F>
-	BoundsEval solveDiff(F&& func, double diff, Bounds bounds, SolveData& data) const
+	template<Function<P, V> F, IterationRecorder<P, V> Recorder>
+	BoundsEval solveDiff(F&& func, double diff, Bounds bounds, Recorder& data) const
 	{
 		return solveWhile(
 				std::forward<F>(func),
@@ -80,16 +121,16 @@ public:
 				data);
 	}
 
-	template<Function<P, V> F>
-	BoundsEval solveUntilEnd(F&& func, Bounds bounds, SolveData& data) const {
+	template<Function<P, V> F, IterationRecorder<P, V> Recorder>
+	BoundsEval solveUntilEnd(F&& func, Bounds bounds, Recorder& data) const {
 		return solveWhile(
 				std::forward<F>(func),
 				std::move(bounds), [](...) { return true; },
 				data);
 	}
 
-	template<Function<P, V> F>
-	BoundsEval solveUntilEnd(F&& func, BoundsEval bounds, SolveData& data) const {
+	template<Function<P, V> F, IterationRecorder<P, V> Recorder>
+	BoundsEval solveUntilEnd(F&& func, BoundsEval bounds, Recorder& data) const {
 		return solveWhile(
 				std::forward<F>(func),
 				Bounds{bounds.p - bounds.r, bounds.p + bounds.r}, [](...) { return true; },
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "./Approximator.hpp"
+#include "opt-methods/math/Sampling.hpp"
+#include "opt-methods/util/ThreadPool.hpp"
+
+template<typename P, typename V>
+struct MultiStartResult
+{
+	std::size_t start; // index of start point
+	P startPoint;
+	PointRegion<P> region; // last yielded region, start if there were no iterations
+	V value;               // at region.p
+	std::size_t iterations;
+	std::size_t minimum; // index of distinct minimum this run converged to
+};
+
+template<typename P, typename V>
+struct DistinctMinimum
+{
+	P p; // as found by first start
+	V v;
+	std::size_t firstStart;
+	std::size_t hits = 1;
+};
+
+/**
+ * runs approximator from many sampled start points on pool, threads take starts in small chunks,
+ * results are reported in start order and minima closer than tolerance are merged,
+ * so output does not depend on thread count
+ * approximator and function must be safe to use from several threads
+ */
+template<typename P, typename V, Approximator<P, V> Approx>
+	requires std::same_as<P, Vector<Scalar<P>>>
+class MultiStart
+{
+public:
+	using S = Scalar<P>;
+
+	Approx approximator;
+	std::shared_ptr<util::ThreadPool> pool;
+	S radius;    // of start regions
+	S tolerance; // distance between merged minima
+	std::size_t maxIterations;
+	std::size_t chunk; // starts taken by thread at once, results wait for report about pool size times chunk
+
+	/**
+	 * @param pool -- run sequentially if null
+	 */
+	MultiStart(Approx approximator, std::shared_ptr<util::ThreadPool> pool, S radius, S tolerance, std::size_t maxIterations = 10'000, std::size_t chunk = 1)
+	: approximator(std::move(approximator))
+	, pool(std::move(pool))
+	, radius(radius)
+	, tolerance(tolerance)
+	, maxIterations(maxIterations)
+	, chunk(chunk)
+	{}
+
+private:
+	/**
+	 * minima in cells of side tolerance, neighbour cells are checked on lookup,
+	 * ids are consecutive from 0
+	 */
+	class SpatialHash
+	{
+	private:
+		S cell;
+		std::unordered_map<std::uint64_t, std::vector<std::size_t>> cells;
+		std::size_t count = 0;
+
+		std::vector<std::int64_t> Coords(P const& p) const
+		{
+			std::vector<std::int64_t> res(p.size());
+			for (std::size_t i = 0; i < p.size(); i++)
+				res[i] = static_cast<std::int64_t>(std::floor(p[i] / cell));
+			return res;
+		}
+
+		static std::uint64_t Key(std::vector<std::int64_t> const& c) noexcept
+		{
+			std::uint64_t h = 1469598103934665603ULL;
+			for (auto x : c)
+				h = (h ^ static_cast<std::uint64_t>(x)) * 1099511628211ULL;
+			return h;
+		}
+
+	public:
+		explicit SpatialHash(S cell)
+		: cell(cell > 0 ? cell : S(1))
+		{}
+
+		template<typename Near>
+		std::optional<std::size_t> find(P const& p, Near&& near) const
+		{
+			// walk over 3^dim neighbour cells only while there are more minima than cells
+			std::size_t neighbours = 1;
+			for (std::size_t i = 0; i < p.size() && neighbours <= count; i++)
+				neighbours *= 3;
+			if (neighbours > count)
+			{
+				for (std::size_t id = 0; id < count; id++)
+					if (near(id))
+						return id;
+				return {};
+			}
+
+			auto base = Coords(p), c = base;
+			std::vector<int> offset(p.size(), -1);
+			while (true)
+			{
+				for (std::size_t i = 0; i < c.size(); i++)
+					c[i] = base[i] + offset[i];
+				if (auto it = cells.find(Key(c)); it != cells.end())
+					for (auto id : it->second)
+						if (near(id))
+							return id;
+				std::size_t i = 0;
+				while (i < offset.size() && offset[i] == 1)
+					offset[i++] = -1;
+				if (i == offset.size())
+					return {};
+				offset[i]++;
+			}
+		}
+
+		void insert(P const& p, std::size_t id)
+		{
+			assert(id == count);
+			cells[Key(Coords(p))].push_back(id);
+			count++;
+		}
+	};
+
+public:
+	/**
+	 * @param box -- sampler points are scaled to [box.p - box.r, box.p + box.r] in each coordinate
+	 * @param onResult -- called with each result in start order, under lock
+	 * @return distinct minima in order of discovery
+	 */
+	template<Function<P, V> F, UnitSampler<S> Sampler, typename Callback = void (*)(MultiStartResult<P, V> const&)>
+	std::vector<DistinctMinimum<P, V>> solve(
+			F const& func, Sampler const& sampler, std::size_t starts, PointRegion<P> const& box,
+			Callback&& onResult = [](MultiStartResult<P, V> const&) {}) const
+	{
+		std::deque<std::optional<MultiStartResult<P, V>>> pending; // starts from emitted on
+		std::size_t emitted = 0;
+		std::vector<DistinctMinimum<P, V>> minima;
+		SpatialHash hash(tolerance);
+		std::mutex m;
+
+		// merges ready results in start order
+		auto emit = [&]() {
+			while (!pending.empty() && pending.front().has_value())
+			{
+				auto& res = *pending.front();
+				auto found = hash.find(res.region.p, [&](std::size_t id) { return Len(P(minima[id].p - res.region.p)) <= tolerance; });
+				if (found.has_value())
+				{
+					minima[*found].hits++;
+					res.minimum = *found;
+				}
+				else
+				{
+					res.minimum = minima.size();
+					minima.push_back({res.region.p, res.value, res.start});
+					hash.insert(res.region.p, res.minimum);
+				}
+				onResult(res);
+				pending.pop_front();
+				emitted++;
+			}
+		};
+
+		util::ChunkedFor(pool.get(), starts, chunk, [&](std::size_t i) {
+			P start = sampler(i);
+			assert(start.size() == box.p.size());
+			start = box.p + (S(2) * start - S(1)) * box.r;
+
+			auto gen = approximator(func, PointRegion<P>{start, radius});
+			PointRegion<P> last{start, radius};
+			std::size_t iterations = 0;
+			while (iterations < maxIterations && gen.next())
+			{
+				iterations++;
+				last = gen.getValue();
+			}
+			V value = func(last.p);
+
+			std::unique_lock lock(m);
+			if (pending.size() <= i - emitted)
+				pending.resize(i - emitted + 1);
+			pending[i - emitted].emplace(MultiStartResult<P, V>{i, std::move(start), std::move(last), value, iterations, 0});
+			emit();
+		});
+		return minima;
+	}
+};
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <tuple>
+#include <vector>
+
+#include "./BudgetedSolver.hpp"
+#include "opt-methods/util/ThreadPool.hpp"
+
+enum class PortfolioOutcome
+{
+	Converged, // approximator stopped within tolerance or reached target
+	Stopped,   // approximator stopped by itself with wider region, does not win
+	Cancelled, // other method converged first
+	IterationLimit,
+};
+
+inline char const* ToString(PortfolioOutcome o) noexcept
+{
+	switch (o)
+	{
+	case PortfolioOutcome::Converged:      return "converged";
+	case PortfolioOutcome::Stopped:        return "stopped";
+	case PortfolioOutcome::Cancelled:      return "cancelled";
+	case PortfolioOutcome::IterationLimit: return "iteration limit";
+	}
+	return "unknown";
+}
+
+template<typename P, typename V>
+struct PortfolioMethodReport
+{
+	char const* name = "";
+	PortfolioOutcome outcome = PortfolioOutcome::Cancelled;
+	std::optional<PointRegion<P>> region;    // last yielded region
+	std::optional<PointAndValue<P, V>> best; // best point evaluated by this method
+	std::size_t iterations = 0, evaluations = 0, gradients = 0, hessians = 0;
+	std::chrono::steady_clock::duration time{};
+};
+
+template<typename P, typename V>
+struct PortfolioResult
+{
+	std::optional<std::size_t> winner;       // index of first converged method
+	std::optional<PointAndValue<P, V>> best; // best point over all methods
+	std::vector<PortfolioMethodReport<P, V>> methods;
+
+	/// work of methods except winner
+	PortfolioMethodReport<P, V> wasted() const
+	{
+		PortfolioMethodReport<P, V> res{"losers"};
+		for (std::size_t i = 0; i < methods.size(); i++)
+			if (!winner.has_value() || i != *winner)
+			{
+				res.iterations += methods[i].iterations;
+				res.evaluations += methods[i].evaluations;
+				res.gradients += methods[i].gradients;
+				res.hessians += methods[i].hessians;
+				res.time += methods[i].time;
+			}
+		return res;
+	}
+};
+
+template<typename P, typename V>
+struct PortfolioOptions
+{
+	std::optional<V> target; // value considered converged, checked after each iteration
+	Scalar<P> tolerance = 0; // method which stopped by itself converged if radius of its last region is not greater
+	std::size_t maxIterations = Budget::unlimited;
+};
+
+/**
+ * runs several approximators concurrently from the same start,
+ * first one to converge cancels the rest (they stop before their next iteration),
+ * methods which stop without converging let others continue
+ * function is copied to each method and must be safe to call from several threads
+ */
+template<typename P, typename V, Approximator<P, V> ... A>
+class PortfolioSolver
+{
+public:
+	using Options = PortfolioOptions<P, V>;
+
+	std::tuple<A...> approximators;
+	std::shared_ptr<util::ThreadPool> pool;
+
+	/**
+	 * @param pool -- run methods one after another if null
+	 */
+	PortfolioSolver(std::shared_ptr<util::ThreadPool> pool, A... approximators)
+	: approximators(std::move(approximators)...)
+	, pool(std::move(pool))
+	{}
+
+private:
+	struct Shared
+	{
+		std::stop_source stop;
+		std::mutex m;
+		std::optional<std::size_t> winner;
+		std::optional<PointAndValue<P, V>> best;
+
+		void offer(std::optional<PointAndValue<P, V>> const& candidate)
+		{
+			if (!candidate.has_value())
+				return;
+			std::unique_lock lock(m);
+			if (!best.has_value() || candidate->v < best->v)
+				best = candidate;
+		}
+
+		void win(std::size_t index)
+		{
+			{
+				std::unique_lock lock(m);
+				if (!winner.has_value())
+					winner = index;
+			}
+			stop.request_stop();
+		}
+	};
+
+	template<std::size_t I, Function<P, V> F>
+	void run(F const& func, PointRegion<P> const& start, Options const& options, Shared& shared, PortfolioMethodReport<P, V>& report) const
+	{
+		auto const& approx = std::get<I>(approximators);
+		if constexpr (impl::hasName<std::tuple_element_t<I, std::tuple<A...>>>)
+			report.name = approx.name();
+		else
+			report.name = "<unknown>";
+
+		auto token = shared.stop.get_token();
+		if (token.stop_requested())
+			return;
+
+		auto begin = std::chrono::steady_clock::now();
+		impl::EvaluationLog<P, V> log;
+		auto gen = approx(impl::CountingProxy<P, V, F>(func, log), start);
+		while (true)
+		{
+			if (token.stop_requested())
+			{
+				report.outcome = PortfolioOutcome::Cancelled;
+				break;
+			}
+			if (report.iterations >= options.maxIterations)
+			{
+				report.outcome = PortfolioOutcome::IterationLimit;
+				break;
+			}
+			if (!gen.next())
+			{
+				if (report.region.has_value() && report.region->r <= options.tolerance)
+				{
+					report.outcome = PortfolioOutcome::Converged;
+					shared.win(I);
+				}
+				else
+					report.outcome = PortfolioOutcome::Stopped;
+				break;
+			}
+			report.iterations++;
+			report.region = gen.getValue();
+			if (options.target.has_value() && log.best.has_value() && log.best->v <= *options.target)
+			{
+				report.outcome = PortfolioOutcome::Converged;
+				shared.win(I);
+				break;
+			}
+		}
+		report.time = std::chrono::steady_clock::now() - begin;
+		shared.offer(log.best);
+		report.best = std::move(log.best);
+		report.evaluations = log.counters.evaluations;
+		report.gradients = log.counters.gradients;
+		report.hessians = log.counters.hessians;
+	}
+
+public:
+	template<Function<P, V> F>
+	PortfolioResult<P, V> solve(F const& func, PointRegion<P> const& start, Options const& options = {}) const
+	{
+		Shared shared;
+		PortfolioResult<P, V> res;
+		res.methods.resize(sizeof...(A));
+
+		util::ParallelFor(pool.get(), sizeof...(A), [&](std::size_t i) {
+			[&]<std::size_t... Is>(std::index_sequence<Is...>) {
+				((i == Is ? run<Is>(func, start, options, shared, res.methods[Is]) : void()), ...);
+			}(std::index_sequence_for<A...>());
+		});
+
+		res.winner = shared.winner;
+		res.best = std::move(shared.best);
+		return res;
+	}
+};
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "./IterationDataBuffer.hpp"
+
+/**
+ * what solver keeps about each iteration,
+ * region is the one iteration started from, counters are zero without counting policy
+ * iteration rejected by stop condition is recorded too, recorder may also have finish(region) called with region solver returns
+ */
+template<typename R, typename P, typename V>
+concept IterationRecorder = requires(R& r, ApproxGenerator<P, V> const& gen, PointRegion<P> const& region, EvaluationCounters const& counters) {
+	r.record(gen, region, counters);
+};
+
+/**
+ * keeps nothing but totals
+ */
+struct NoRecording
+{
+	std::size_t iterations = 0;
+	EvaluationCounters counters;
+
+	template<typename P, typename V>
+	void record(ApproxGenerator<P, V> const&, PointRegion<P> const&, EvaluationCounters const& c) noexcept
+	{
+		iterations++;
+		counters += c;
+	}
+
+	std::size_t size() const noexcept { return iterations; }
+};
+
+/**
+ * keeps region solver returned, none if nothing was recorded
+ */
+template<typename P>
+struct FinalOnly : NoRecording
+{
+	std::optional<PointRegion<P>> last;
+
+	void finish(PointRegion<P> const& region)
+	{
+		if (iterations > 0)
+			last = region;
+	}
+};
+
+/**
+ * every k-th iteration data with region, full recording when k is 1
+ */
+template<typename P, typename V>
+class EveryKth : public IterationDataBuffer<P, V>
+{
+private:
+	std::size_t k, seen = 0;
+
+public:
+	explicit EveryKth(std::size_t k = 1)
+	: k(k == 0 ? 1 : k)
+	{}
+
+	void record(ApproxGenerator<P, V> const& gen, PointRegion<P> const& region, EvaluationCounters const& c)
+	{
+		if (seen++ % k == 0)
+			IterationDataBuffer<P, V>::record(gen, region, c);
+	}
+
+	std::size_t iterations() const noexcept { return seen; }
+};
+
+/**
+ * points-only recorder: rows of (iteration, point coordinates, radius) in contiguous columns,
+ * keeps every k-th row, when capacity is given the oldest rows are overwritten
+ */
+template<typename P>
+class ColumnarRecorder
+{
+public:
+	using S = Scalar<P>;
+
+private:
+	std::size_t every, capacity;
+	std::size_t dim = 0;
+	std::size_t seen = 0, rows = 0, head = 0; // head -- slot of oldest row when full
+	std::vector<S> points, radii;
+	std::vector<std::size_t> iters;
+	EvaluationCounters total;
+
+	std::size_t slot(std::size_t i) const noexcept { return capacity == 0 ? i : (head + i) % capacity; }
+
+	static std::size_t Dim(P const& p) noexcept
+	{
+		if constexpr (std::is_arithmetic_v<P>)
+			return 1;
+		else
+			return p.size();
+	}
+
+public:
+	/**
+	 * @param capacity -- rows to keep, 0 for unbounded
+	 */
+	explicit ColumnarRecorder(std::size_t every = 1, std::size_t capacity = 0)
+	: every(every == 0 ? 1 : every)
+	, capacity(capacity)
+	{}
+
+	template<typename V>
+	void record(ApproxGenerator<P, V> const&, PointRegion<P> const& region, EvaluationCounters const& c)
+	{
+		total += c;
+		if (seen++ % every != 0)
+			return;
+		if (rows == 0 && head == 0)
+			dim = Dim(region.p);
+		assert(Dim(region.p) == dim);
+
+		std::size_t s;
+		if (capacity == 0 || rows < capacity)
+		{
+			s = rows++;
+			points.resize(rows * dim);
+			radii.resize(rows);
+			iters.resize(rows);
+		}
+		else
+		{
+			s = head;
+			head = (head + 1) % capacity;
+		}
+		if constexpr (std::is_arithmetic_v<P>)
+			points[s] = region.p;
+		else
+			std::copy(std::begin(region.p), std::end(region.p), points.begin() + s * dim);
+		radii[s] = region.r;
+		iters[s] = seen - 1;
+	}
+
+	/// kept rows, oldest first
+	std::size_t size() const noexcept { return rows; }
+	/// recorded iterations, including skipped and overwritten
+	std::size_t iterations() const noexcept { return seen; }
+	std::size_t dimension() const noexcept { return dim; }
+	EvaluationCounters const& counters() const noexcept { return total; }
+
+	std::span<S const> point(std::size_t i) const noexcept { return {points.data() + slot(i) * dim, dim}; }
+	S radius(std::size_t i) const noexcept { return radii[slot(i)]; }
+	std::size_t iteration(std::size_t i) const noexcept { return iters[slot(i)]; }
+
+	void clear() noexcept
+	{
+		seen = rows = head = 0;
+		points.clear(), radii.clear(), iters.clear();
+		total = {};
+	}
+};
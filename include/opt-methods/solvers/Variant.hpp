@@ -0,0 +1,106 @@
+#pragma once
+
+#include "./Approximator.hpp"
+#include "./Erased.hpp"
+
+#include <cassert>
+#include <cstdlib>
+#include <variant>
+
+namespace impl
+{
+	template<typename A, typename F, typename P>
+	concept AppliesTo = requires(A const& a, F func, PointRegion<P> r) {
+		a(std::move(func), std::move(r));
+	};
+}
+
+/**
+ * approximator chosen at runtime from closed list, alternative to ErasedApproximator:
+ * every method is instantiated with concrete function type and dispatch is one std::visit per run,
+ * so function, gradient and hessian calls in iterations are direct and can be inlined
+ * functions may also be chosen at runtime by passing std::variant of them,
+ * pairs where method does not accept function abort when selected
+ */
+template<typename From, typename To, Approximator<From, To>... A>
+class VariantApproximator
+{
+public:
+	using P = From;
+	using V = To;
+
+private:
+	std::variant<A...> approx;
+
+	template<typename F>
+	static ApproxGenerator<P, V> run(auto const& a, F&& func, PointRegion<P> r)
+	{
+		if constexpr (impl::AppliesTo<std::decay_t<decltype(a)>, std::decay_t<F>, P>)
+			return a(std::forward<F>(func), std::move(r));
+		else
+			abort(); // method does not support this function
+	}
+
+	template<typename F>
+	static std::optional<PointRegion<P>> runDirect(auto const& a, F&& func, PointRegion<P> r)
+	{
+		if constexpr (impl::AppliesTo<std::decay_t<decltype(a)>, std::decay_t<F>, P>)
+			return impl::Minimize<P, V>(a, std::forward<F>(func), std::move(r));
+		else
+			abort(); // method does not support this function
+	}
+
+public:
+	template<Approximator<P, V> Approx, typename... Args>
+		requires (std::same_as<Approx, A> || ...)
+	VariantApproximator(TypeTag<Approx>, Args&&... args)
+	: approx(std::in_place_type<Approx>, std::forward<Args>(args)...)
+	{}
+
+	template<typename F>
+		requires Function<std::decay_t<F>, P, V>
+	ApproxGenerator<P, V> operator()(F&& func, PointRegion<P> bounds) const
+	{
+		return std::visit([&](auto const& a) { return run(a, std::forward<F>(func), std::move(bounds)); }, approx);
+	}
+
+	template<Function<P, V>... Fs>
+	ApproxGenerator<P, V> operator()(std::variant<Fs...> const& func, PointRegion<P> bounds) const
+	{
+		return std::visit([&](auto const& a, auto const& f) { return run(a, f, std::move(bounds)); }, approx, func);
+	}
+
+	/// runs to the end and returns last yielded region, see DirectApproximator, methods without direct mode run their coroutine
+	template<typename F>
+		requires Function<std::decay_t<F>, P, V>
+	std::optional<PointRegion<P>> minimize(F&& func, PointRegion<P> bounds) const
+	{
+		return std::visit([&](auto const& a) { return runDirect(a, std::forward<F>(func), std::move(bounds)); }, approx);
+	}
+
+	/// see impl::ForRun
+	VariantApproximator forRun() const requires (impl::HasRunState<A> || ...)
+	{
+		return std::visit([](auto const& a) { return VariantApproximator(typeTag<std::decay_t<decltype(a)>>, impl::ForRun(a)); }, approx);
+	}
+
+	void draw(BoundsWithValues<P, V> bounds, BaseIterationData<P, V> const& data, QtCharts::QChart& chart) const
+	{
+		std::visit([&](auto const& a) { a.draw(std::move(bounds), data, chart); }, approx);
+	}
+
+	char const* name() const noexcept
+	{
+		return std::visit([](auto const& a) noexcept -> char const* {
+			if constexpr (impl::hasName<std::decay_t<decltype(a)>>)
+				return a.name();
+			else
+				return "<variant unknown>";
+		}, approx);
+	}
+
+	std::size_t index() const noexcept { return approx.index(); }
+
+	template<Approximator<P, V> Approx>
+	Approx const* target() const noexcept { return std::get_if<Approx>(&approx); }
+};
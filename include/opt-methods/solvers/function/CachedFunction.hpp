@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "../Erased.hpp"
+#include "opt-methods/math/HessVec.hpp"
+
+namespace impl
+{
+	/**
+	 * bitwise key of a point: scalars and vectors of scalars
+	 */
+	template<typename P>
+	std::string PointBits(P const& p)
+	{
+		if constexpr (std::is_arithmetic_v<P>)
+			return std::string(reinterpret_cast<char const*>(&p), sizeof(p));
+		else
+		{
+			std::string res(sizeof(p[0]) * p.size(), '\0');
+			if (p.size() != 0)
+				std::memcpy(res.data(), std::addressof(p[0]), res.size());
+			return res;
+		}
+	}
+}
+
+/**
+ * memoising wrapper: exact-match LRU cache of function values keyed by point bits
+ * copies share cache and counters, because approximators take functions by value,
+ * cache is guarded by mutex, so copies may be called from pooled methods; function itself is evaluated unlocked
+ * grad() and hessian() are forwarded to the wrapped function uncached
+ */
+template<typename P, typename V, Function<P, V> F>
+class CachedFunction
+{
+private:
+	struct State
+	{
+		using Entry = std::pair<std::string, V>;
+
+		std::size_t capacity;
+		std::list<Entry> entries; // most recently used first
+		std::unordered_map<std::string_view, typename std::list<Entry>::iterator> index;
+		std::size_t hits = 0, misses = 0;
+		mutable std::mutex mutex;
+
+		State(std::size_t capacity)
+		: capacity(capacity)
+		{}
+	};
+
+	F func;
+	std::shared_ptr<State> state;
+
+public:
+	CachedFunction(TypeTag<P>, TypeTag<V>, F func, std::size_t capacity = 1024)
+	: func(std::move(func))
+	, state(std::make_shared<State>(capacity))
+	{}
+
+	V operator()(P const& p) const
+	{
+		auto& st = *state;
+		auto key = impl::PointBits(p);
+		{
+			std::lock_guard lock(st.mutex);
+			if (auto it = st.index.find(key); it != st.index.end())
+			{
+				st.hits++;
+				st.entries.splice(st.entries.begin(), st.entries, it->second);
+				return it->second->second;
+			}
+			st.misses++;
+		}
+		V res = func(p);
+		if (st.capacity == 0)
+			return res;
+		std::lock_guard lock(st.mutex);
+		if (st.index.contains(key)) // stored by other thread meanwhile
+			return res;
+		if (st.entries.size() >= st.capacity)
+		{
+			st.index.erase(st.entries.back().first);
+			st.entries.pop_back();
+		}
+		st.entries.emplace_front(std::move(key), res);
+		st.index.emplace(st.entries.front().first, st.entries.begin());
+		return res;
+	}
+
+	auto grad() const requires HasGrad<F>
+	{
+		return func.grad();
+	}
+
+	auto hessian() const requires HasHessian<F>
+	{
+		return func.hessian();
+	}
+
+	P hessVec(P const& x, P const& v) const requires HasHessVec<F, P>
+	{
+		return func.hessVec(x, v);
+	}
+
+	F const& underlying() const noexcept { return func; }
+
+	std::size_t hits() const
+	{
+		std::lock_guard lock(state->mutex);
+		return state->hits;
+	}
+
+	std::size_t misses() const
+	{
+		std::lock_guard lock(state->mutex);
+		return state->misses;
+	}
+
+	void clear()
+	{
+		std::lock_guard lock(state->mutex);
+		state->entries.clear();
+		state->index.clear();
+		state->hits = state->misses = 0;
+	}
+};
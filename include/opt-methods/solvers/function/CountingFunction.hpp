@@ -0,0 +1,53 @@
+#pragma once
+
+#include "./function-helper.hpp"
+#include "opt-methods/math/HessVec.hpp"
+#include "opt-methods/solvers/Counters.hpp"
+
+namespace impl
+{
+	/**
+	 * function proxy adding evaluations to counters, may be called from several threads
+	 */
+	template<typename P, typename V, typename F>
+	class CountingFunction
+	{
+	private:
+		F func;
+		EvaluationCounters* counters;
+
+	public:
+		CountingFunction(F func, EvaluationCounters& counters)
+		: func(std::move(func))
+		, counters(&counters)
+		{}
+
+		V operator()(P const& x) const
+		{
+			AtomicIncrement(counters->evaluations);
+			return func(x);
+		}
+
+		auto grad() const requires HasGrad<F>
+		{
+			return [g = func.grad(), counters = counters](P const& x) {
+				AtomicIncrement(counters->gradients);
+				return g(x);
+			};
+		}
+
+		auto hessian() const requires HasHessian<F>
+		{
+			return [h = func.hessian(), counters = counters](P const& x) {
+				AtomicIncrement(counters->hessians);
+				return h(x);
+			};
+		}
+
+		P hessVec(P const& x, P const& v) const requires HasHessVec<F, P>
+		{
+			AtomicIncrement(counters->hessians);
+			return func.hessVec(x, v);
+		}
+	};
+}
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "../Erased.hpp"
+#include "opt-methods/math/DenseMatrix.hpp"
+#include "opt-methods/util/ThreadPool.hpp"
+
+enum class DifferenceScheme
+{
+	Forward,
+	Central,
+	ComplexStep,
+};
+
+/**
+ * for each row of hessian -- indices of possibly nonzero columns, diagonal included
+ */
+using SparsityPattern = std::vector<std::vector<std::size_t>>;
+
+namespace impl
+{
+	/**
+	 * greedy Curtis-Powell-Reid colouring: columns of one colour have no common nonzero row,
+	 * so they can be perturbed simultaneously
+	 */
+	inline std::vector<std::vector<std::size_t>> ColourColumns(SparsityPattern const& pattern)
+	{
+		std::size_t n = pattern.size();
+		// rows where column has nonzero; pattern is symmetric, so it is the same list
+		std::vector<int> colour(n, -1);
+		std::vector<std::vector<std::size_t>> res;
+		std::vector<int> usedBy(n, -1);
+		for (std::size_t j = 0; j < n; j++)
+		{
+			// forbid colours of columns sharing a row with j
+			for (auto row : pattern[j])
+				for (auto col : pattern[row])
+					if (colour[col] != -1)
+						usedBy[colour[col]] = (int)j;
+			int c = 0;
+			while (c < (int)res.size() && usedBy[c] == (int)j)
+				c++;
+			if (c == (int)res.size())
+				res.emplace_back();
+			colour[j] = c;
+			res[c].push_back(j);
+		}
+		return res;
+	}
+}
+
+/**
+ * derivative adaptor for black box functions of vector argument
+ * perturbed points are evaluated concurrently when thread pool is given,
+ * so wrapped function must be safe to call from several threads
+ * complex step is used only if function accepts complex vector, central differences otherwise
+ */
+template<typename P, typename V, Function<P, V> F>
+class FiniteDifferenceFunction
+{
+private:
+	using S = Scalar<P>;
+
+	struct Engine
+	{
+		F func;
+		DifferenceScheme scheme;
+		std::shared_ptr<util::ThreadPool> pool;
+		SparsityPattern pattern;
+		std::vector<std::vector<std::size_t>> colours;
+
+		static constexpr bool supportsComplex = std::is_invocable_v<F const&, Vector<std::complex<S>> const&>;
+
+		static S Step(S x, S power)
+		{
+			using std::abs;
+			using std::max;
+			using std::pow;
+			return pow(std::numeric_limits<S>::epsilon(), power) * max(S(1), abs(x));
+		}
+
+		void Evaluate(std::size_t n, auto&& point, std::vector<S>& out) const
+		{
+			out.resize(n);
+			util::ParallelFor(pool.get(), n, [&](std::size_t k) { out[k] = static_cast<S>(func(point(k))); });
+		}
+
+		P Grad(P const& x) const
+		{
+			std::size_t n = x.size();
+			P res(S(0), n);
+			std::vector<S> f;
+			switch (scheme)
+			{
+			case DifferenceScheme::Forward:
+				Evaluate(n + 1, [&](std::size_t k) {
+					P y = x;
+					if (k < n)
+						y[k] += Step(x[k], S(0.5));
+					return y;
+				}, f);
+				for (std::size_t i = 0; i < n; i++)
+					res[i] = (f[i] - f[n]) / Step(x[i], S(0.5));
+				break;
+			case DifferenceScheme::Central:
+				Evaluate(2 * n, [&](std::size_t k) {
+					P y = x;
+					y[k / 2] += k % 2 == 0 ? Step(x[k / 2], S(1) / 3) : -Step(x[k / 2], S(1) / 3);
+					return y;
+				}, f);
+				for (std::size_t i = 0; i < n; i++)
+					res[i] = (f[2 * i] - f[2 * i + 1]) / (2 * Step(x[i], S(1) / 3));
+				break;
+			case DifferenceScheme::ComplexStep:
+				if constexpr (supportsComplex)
+				{
+					constexpr S h = std::numeric_limits<S>::epsilon() * std::numeric_limits<S>::epsilon();
+					util::ParallelFor(pool.get(), n, [&](std::size_t i) {
+						Vector<std::complex<S>> y(n);
+						for (std::size_t j = 0; j < n; j++)
+							y[j] = x[j];
+						y[i] += std::complex<S>(0, h);
+						res[i] = std::imag(func(y)) / h;
+					});
+				}
+				break;
+			}
+			return res;
+		}
+
+		/// hessian from function values, only (i, j) pairs listed are evaluated
+		DenseMatrix<S> HessianFromValues(P const& x, std::vector<std::pair<std::size_t, std::size_t>> const& pairs) const
+		{
+			std::size_t n = x.size();
+			DenseMatrix<S> res(n, std::valarray<S>(S(0), n * n));
+			std::vector<S> f;
+			Evaluate(4 * pairs.size(), [&](std::size_t k) {
+				auto [i, j] = pairs[k / 4];
+				P y = x;
+				y[i] += (k & 1) ? -Step(x[i], S(0.25)) : Step(x[i], S(0.25));
+				y[j] += (k & 2) ? -Step(x[j], S(0.25)) : Step(x[j], S(0.25));
+				return y;
+			}, f);
+			for (std::size_t k = 0; k < pairs.size(); k++)
+			{
+				auto [i, j] = pairs[k];
+				auto h = (f[4 * k] - f[4 * k + 1] - f[4 * k + 2] + f[4 * k + 3]) / (4 * Step(x[i], S(0.25)) * Step(x[j], S(0.25)));
+				res.At(i, j) = res.At(j, i) = h;
+			}
+			return res;
+		}
+
+		/// hessian from gradient differences along coloured directions
+		template<typename G>
+		DenseMatrix<S> HessianFromGradient(P const& x, G const& grad) const
+		{
+			std::size_t n = x.size();
+			DenseMatrix<S> res(n, std::valarray<S>(S(0), n * n));
+			auto gradx = grad(x);
+			std::vector<P> diffs(colours.size());
+			util::ParallelFor(pool.get(), colours.size(), [&](std::size_t c) {
+				P y = x;
+				for (auto j : colours[c])
+					y[j] += Step(x[j], S(0.5));
+				diffs[c] = grad(y) - gradx;
+			});
+			for (std::size_t c = 0; c < colours.size(); c++)
+				for (auto j : colours[c])
+					for (auto i : pattern[j])
+						res.At(i, j) = diffs[c][i] / Step(x[j], S(0.5));
+			for (std::size_t i = 0; i < n; i++)
+				for (auto j : pattern[i])
+					if (i < j)
+						res.At(i, j) = res.At(j, i) = (res.At(i, j) + res.At(j, i)) / 2;
+			return res;
+		}
+
+		DenseMatrix<S> Hessian(P const& x) const
+		{
+			std::size_t n = x.size();
+			if (!pattern.empty())
+			{
+				assert(pattern.size() == n);
+				if constexpr (HasGrad<F>)
+					return HessianFromGradient(x, func.grad());
+				else
+					return HessianFromGradient(x, [this](P const& y) { return Grad(y); });
+			}
+			std::vector<std::pair<std::size_t, std::size_t>> pairs;
+			for (std::size_t i = 0; i < n; i++)
+				for (std::size_t j = i; j < n; j++)
+					pairs.emplace_back(i, j);
+			return HessianFromValues(x, pairs);
+		}
+	};
+
+	std::shared_ptr<const Engine> engine;
+
+public:
+	class GradientFunc
+	{
+	private:
+		std::shared_ptr<const Engine> engine;
+
+	public:
+		GradientFunc(std::shared_ptr<const Engine> engine)
+		: engine(std::move(engine))
+		{}
+
+		P operator()(P const& x) const { return engine->Grad(x); }
+	};
+
+	class HessianFunc
+	{
+	private:
+		std::shared_ptr<const Engine> engine;
+
+	public:
+		HessianFunc(std::shared_ptr<const Engine> engine)
+		: engine(std::move(engine))
+		{}
+
+		DenseMatrix<S> operator()(P const& x) const { return engine->Hessian(x); }
+	};
+
+	/**
+	 * @param pool -- evaluate sequentially if null
+	 * @param pattern -- hessian sparsity, enables colouring; empty for dense hessian
+	 */
+	FiniteDifferenceFunction(TypeTag<P>, TypeTag<V>, F func,
+	                         DifferenceScheme scheme                 = DifferenceScheme::Central,
+	                         std::shared_ptr<util::ThreadPool> pool = {},
+	                         SparsityPattern pattern                 = {})
+	{
+		if (scheme == DifferenceScheme::ComplexStep && !Engine::supportsComplex)
+			scheme = DifferenceScheme::Central;
+		auto colours = impl::ColourColumns(pattern);
+		engine = std::make_shared<const Engine>(
+		    Engine{std::move(func), scheme, std::move(pool), std::move(pattern), std::move(colours)});
+	}
+
+	V operator()(P const& x) const { return engine->func(x); }
+
+	GradientFunc grad() const { return {engine}; }
+	HessianFunc hessian() const { return {engine}; }
+};
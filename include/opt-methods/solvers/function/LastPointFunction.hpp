@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+
+#include "./function-helper.hpp"
+#include "opt-methods/math/HessVec.hpp"
+
+namespace impl
+{
+	template<typename P>
+	bool SamePoint(P const& a, P const& b) noexcept
+	{
+		if constexpr (std::is_arithmetic_v<P>)
+			return std::memcmp(&a, &b, sizeof(P)) == 0;
+		else
+			return a.size() == b.size() && (a.size() == 0 || std::memcmp(&a[0], &b[0], sizeof(a[0]) * a.size()) == 0);
+	}
+
+	/**
+	 * value and gradient at points they were last computed at
+	 */
+	template<typename P, typename V>
+	struct LastPointCache
+	{
+		std::mutex mutex;
+		bool hasValue = false, hasGrad = false;
+		P valueX{}, gradX{}, grad{};
+		V value{};
+
+		template<typename Archive>
+		void serialize(Archive& ar)
+		{
+			ar(hasValue, hasGrad, valueX, gradX, grad, value);
+		}
+	};
+
+	/**
+	 * function proxy answering repeated value or gradient request at the same point from cache,
+	 * so convergence checks share evaluations with approximator, may be called from several threads
+	 */
+	template<typename P, typename V, typename F>
+	class LastPointFunction
+	{
+	private:
+		F func;
+		LastPointCache<P, V>* cache;
+
+	public:
+		LastPointFunction(F func, LastPointCache<P, V>& cache)
+		: func(std::move(func))
+		, cache(&cache)
+		{}
+
+		V operator()(P const& x) const
+		{
+			{
+				std::lock_guard lock(cache->mutex);
+				if (cache->hasValue && SamePoint(cache->valueX, x))
+					return cache->value;
+			}
+			V res = func(x);
+			std::lock_guard lock(cache->mutex);
+			cache->hasValue = true, cache->valueX = x, cache->value = res;
+			return res;
+		}
+
+		auto grad() const requires HasGrad<F>
+		{
+			return [g = func.grad(), cache = cache](P const& x) -> P {
+				{
+					std::lock_guard lock(cache->mutex);
+					if (cache->hasGrad && SamePoint(cache->gradX, x))
+						return cache->grad;
+				}
+				P res = g(x);
+				std::lock_guard lock(cache->mutex);
+				cache->hasGrad = true, cache->gradX = x, cache->grad = res;
+				return res;
+			};
+		}
+
+		auto hessian() const requires HasHessian<F>
+		{
+			return func.hessian();
+		}
+
+		P hessVec(P const& x, P const& v) const requires HasHessVec<F, P>
+		{
+			return func.hessVec(x, v);
+		}
+	};
+}
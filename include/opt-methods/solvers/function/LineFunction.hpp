@@ -0,0 +1,33 @@
+#pragma once
+
+#include "opt-methods/math/Vector.hpp"
+
+/**
+ * restriction of function on ray x - alpha * dir
+ * grad() gives derivative on alpha, it costs one gradient evaluation
+ * all members are references, so it must not outlive one line search
+ */
+template<typename P, typename F, typename G>
+class LineFunction
+{
+private:
+	F const& func;
+	G const& gradf;
+	P const& x;
+	P const& dir;
+
+public:
+	LineFunction(F const& func, G const& gradf, P const& x, P const& dir)
+	: func(func)
+	, gradf(gradf)
+	, x(x)
+	, dir(dir)
+	{}
+
+	auto operator()(Scalar<P> const& alpha) const { return func(x - alpha * dir); }
+
+	auto grad() const
+	{
+		return [this](Scalar<P> const& alpha) -> Scalar<P> { return -Dot(gradf(x - alpha * dir), dir); };
+	}
+};
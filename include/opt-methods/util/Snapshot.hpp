@@ -0,0 +1,241 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include "opt-methods/math/DenseMatrix.hpp"
+#include "opt-methods/math/Vector.hpp"
+
+namespace util
+{
+	/**
+	 * binary image of approximator state after some iteration,
+	 * values are stored bitwise in native byte order, so resumed run is bit-identical to uninterrupted one
+	 * (on the same build)
+	 */
+	struct Snapshot
+	{
+		std::size_t iteration = 0; // number of iterations yielded before snapshot
+		std::uint64_t tag = 0;       // types of saved states, see StateTag
+		std::uint64_t dimension = 0; // of points
+		std::vector<std::byte> state;
+	};
+
+	/**
+	 * hash of state type names, differs for other approximator, function type or convergence policy
+	 */
+	template<typename... T>
+	std::uint64_t StateTag() noexcept
+	{
+		std::uint64_t h = 1469598103934665603ULL;
+		for (char const* name : {typeid(T).name()...})
+			for (; *name != '\0'; name++)
+				h = (h ^ static_cast<unsigned char>(*name)) * 1099511628211ULL;
+		return h;
+	}
+
+	template<typename P>
+	std::uint64_t Dimension(P const& p) noexcept
+	{
+		if constexpr (std::is_arithmetic_v<P>)
+			return 1;
+		else
+			return p.size();
+	}
+
+	class SnapshotWriter
+	{
+	private:
+		std::vector<std::byte>& out;
+
+		void raw(void const* p, std::size_t n)
+		{
+			auto b = static_cast<std::byte const*>(p);
+			out.insert(out.end(), b, b + n);
+		}
+
+		template<typename T> requires std::is_arithmetic_v<T>
+		void write(T const& t) { raw(&t, sizeof(T)); }
+
+		template<typename T>
+		void write(Vector<T> const& v)
+		{
+			write(static_cast<std::uint64_t>(v.size()));
+			for (auto const& t : v)
+				write(t);
+		}
+
+		template<typename T>
+		void write(DenseMatrix<T> const& m)
+		{
+			write(static_cast<std::uint64_t>(m.n));
+			write(m.data);
+		}
+
+	public:
+		explicit SnapshotWriter(Snapshot& s)
+		: out(s.state)
+		{}
+
+		template<typename... Ts>
+		void operator()(Ts const&... ts) { (write(ts), ...); }
+	};
+
+	/**
+	 * reads are checked against snapshot size, after first bad read all values are zero and ok() is false
+	 */
+	class SnapshotReader
+	{
+	private:
+		std::vector<std::byte> const& in;
+		std::size_t pos = 0;
+		bool failed = false;
+
+		void raw(void* p, std::size_t n)
+		{
+			if (failed || n > in.size() - pos)
+			{
+				failed = true;
+				std::memset(p, 0, n);
+				return;
+			}
+			std::memcpy(p, in.data() + pos, n);
+			pos += n;
+		}
+
+		template<typename T> requires std::is_arithmetic_v<T>
+		void read(T& t) { raw(&t, sizeof(T)); }
+
+		template<typename T>
+		void read(Vector<T>& v)
+		{
+			std::uint64_t n;
+			read(n);
+			if (n > in.size() - pos) // every element takes at least one byte
+			{
+				failed = true;
+				n = 0;
+			}
+			v.resize(n);
+			for (auto& t : v)
+				read(t);
+		}
+
+		template<typename T>
+		void read(DenseMatrix<T>& m)
+		{
+			std::uint64_t n;
+			read(n);
+			read(m.data);
+			if (n == 0 ? m.data.size() != 0 : m.data.size() % n != 0 || m.data.size() / n != n)
+			{
+				failed = true;
+				n = 0;
+				m.data.resize(0);
+			}
+			m.n = n;
+		}
+
+	public:
+		explicit SnapshotReader(Snapshot const& s)
+		: in(s.state)
+		{}
+
+		template<typename... Ts>
+		void operator()(Ts&... ts) { (read(ts), ...); }
+
+		bool ok() const noexcept { return !failed; }
+		bool done() const noexcept { return pos == in.size(); }
+	};
+
+	/**
+	 * state which can be saved and restored, serialize(ar) passes members to archive
+	 */
+	template<typename T>
+	concept Serializable = requires(T& t, SnapshotWriter& w, SnapshotReader& r) {
+		t.serialize(w);
+		t.serialize(r);
+	};
+
+	template<Serializable... T>
+	Snapshot TakeSnapshot(std::size_t iteration, std::uint64_t dimension, T&... t)
+	{
+		Snapshot res{iteration, StateTag<T...>(), dimension, {}};
+		SnapshotWriter ar(res);
+		(t.serialize(ar), ...);
+		return res;
+	}
+
+	/**
+	 * @return false if snapshot was taken from other states or dimension, or is damaged,
+	 * states are then partially overwritten and must not be used
+	 */
+	template<Serializable... T>
+	[[nodiscard]] bool RestoreSnapshot(Snapshot const& s, std::uint64_t dimension, T&... t)
+	{
+		if (s.tag != StateTag<T...>() || s.dimension != dimension)
+			return false;
+		SnapshotReader ar(s);
+		(t.serialize(ar), ...);
+		return ar.ok() && ar.done();
+	}
+
+	/**
+	 * when to take snapshots, save is called from iterating thread before iteration is yielded
+	 */
+	struct Checkpointing
+	{
+		std::size_t every = 0; // iterations, 0 disables
+		std::function<void(Snapshot const&)> save;
+
+		bool due(std::size_t iteration) const noexcept
+		{
+			return every != 0 && save && iteration % every == 0;
+		}
+	};
+
+	inline constexpr std::uint32_t snapshotMagic = 0x4f4d5332; // "OMS2"
+
+	inline void WriteSnapshot(std::ostream& os, Snapshot const& s)
+	{
+		auto put = [&](auto v) { os.write(reinterpret_cast<char const*>(&v), sizeof(v)); };
+		put(snapshotMagic);
+		put(static_cast<std::uint64_t>(s.iteration));
+		put(s.tag);
+		put(s.dimension);
+		put(static_cast<std::uint64_t>(s.state.size()));
+		os.write(reinterpret_cast<char const*>(s.state.data()), static_cast<std::streamsize>(s.state.size()));
+	}
+
+	/// @return none if stream is truncated or not a snapshot
+	inline std::optional<Snapshot> ReadSnapshot(std::istream& is)
+	{
+		auto get = [&](auto& v) { return static_cast<bool>(is.read(reinterpret_cast<char*>(&v), sizeof(v))); };
+		std::uint32_t magic;
+		std::uint64_t iteration, tag, dimension, size;
+		if (!get(magic) || magic != snapshotMagic || !get(iteration) || !get(tag) || !get(dimension) || !get(size))
+			return {};
+		Snapshot res{static_cast<std::size_t>(iteration), tag, dimension, {}};
+		// grow while reading, so huge size in damaged header does not allocate
+		constexpr std::uint64_t block = 1 << 16;
+		for (std::uint64_t read = 0; read < size;)
+		{
+			auto n = std::min(block, size - read);
+			res.state.resize(static_cast<std::size_t>(read + n));
+			if (!is.read(reinterpret_cast<char*>(res.state.data() + read), static_cast<std::streamsize>(n)))
+				return {};
+			read += n;
+		}
+		return res;
+	}
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace util
+{
+	/**
+	 * fixed size pool of worker threads with shared task queue
+	 * waiting thread helps executing queued tasks, so nested ParallelFor does not deadlock
+	 */
+	class ThreadPool
+	{
+	private:
+		std::vector<std::jthread> workers;
+		std::deque<std::function<void()>> tasks;
+		std::mutex m;
+		std::condition_variable cv;
+		bool stopping = false;
+
+		bool runOne(std::unique_lock<std::mutex>& lock)
+		{
+			if (tasks.empty())
+				return false;
+			auto task = std::move(tasks.front());
+			tasks.pop_front();
+			lock.unlock();
+			task();
+			lock.lock();
+			return true;
+		}
+
+	public:
+		explicit ThreadPool(std::size_t nThreads = std::thread::hardware_concurrency())
+		{
+			nThreads = std::max<std::size_t>(nThreads, 1);
+			for (std::size_t i = 0; i < nThreads; i++)
+				workers.emplace_back([this]() {
+					std::unique_lock lock(m);
+					while (true)
+					{
+						cv.wait(lock, [this]() { return stopping || !tasks.empty(); });
+						if (!runOne(lock) && stopping)
+							return;
+					}
+				});
+		}
+
+		ThreadPool(ThreadPool const&) = delete;
+		ThreadPool& operator=(ThreadPool const&) = delete;
+
+		~ThreadPool()
+		{
+			{
+				std::unique_lock lock(m);
+				stopping = true;
+			}
+			cv.notify_all();
+			workers.clear(); // join before queue and mutex are destroyed
+		}
+
+		std::size_t size() const noexcept { return workers.size(); }
+
+		void post(std::function<void()> task)
+		{
+			{
+				std::unique_lock lock(m);
+				tasks.push_back(std::move(task));
+			}
+			cv.notify_one();
+		}
+
+		/**
+		 * calls func(i) for i in [0, n) on pool threads, returns when all calls are done
+		 * exceptions are rethrown in calling thread (first one wins)
+		 */
+		template<typename Func>
+		void ParallelFor(std::size_t n, Func&& func)
+		{
+			if (n == 0)
+				return;
+			std::size_t chunks = std::min(n, size() * 4), left = chunks;
+			std::exception_ptr error;
+			std::condition_variable done;
+			{
+				std::unique_lock lock(m);
+				for (std::size_t c = 0; c < chunks; c++)
+					tasks.push_back([&, c]() {
+						try
+						{
+							for (std::size_t i = c * n / chunks; i < (c + 1) * n / chunks; i++)
+								func(i);
+						}
+						catch (...)
+						{
+							std::unique_lock lock(m);
+							if (!error)
+								error = std::current_exception();
+						}
+						std::unique_lock lock(m);
+						if (--left == 0)
+							done.notify_all();
+					});
+			}
+			cv.notify_all();
+
+			std::unique_lock lock(m);
+			while (left != 0)
+				if (!runOne(lock))
+					done.wait(lock, [&]() { return left == 0 || !tasks.empty(); });
+			lock.unlock();
+			if (error)
+				std::rethrow_exception(error);
+		}
+
+		/**
+		 * calls func(i) for i in [0, n) like ParallelFor, for calls of very different cost:
+		 * workers and calling thread take next chunk of indices from shared counter when done with previous,
+		 * so indices are started roughly in order and at most size() + 1 chunks are in progress
+		 */
+		template<typename Func>
+		void ChunkedFor(std::size_t n, std::size_t chunk, Func&& func)
+		{
+			chunk = std::max<std::size_t>(chunk, 1);
+			std::atomic<std::size_t> next = 0;
+			ParallelFor(std::min(n, size() + 1), [&](std::size_t) {
+				for (std::size_t from; (from = next.fetch_add(chunk, std::memory_order_relaxed)) < n;)
+					for (std::size_t i = from; i < std::min(n, from + chunk); i++)
+						func(i);
+			});
+		}
+	};
+
+	/**
+	 * calls func(i) for i in [0, n) on pool, or sequentially if there is no pool
+	 */
+	template<typename Func>
+	void ParallelFor(ThreadPool* pool, std::size_t n, Func&& func)
+	{
+		if (pool == nullptr)
+			for (std::size_t i = 0; i < n; i++)
+				func(i);
+		else
+			pool->ParallelFor(n, std::forward<Func>(func));
+	}
+
+	/**
+	 * ChunkedFor on pool, or sequential loop if there is no pool
+	 */
+	template<typename Func>
+	void ChunkedFor(ThreadPool* pool, std::size_t n, std::size_t chunk, Func&& func)
+	{
+		if (pool == nullptr)
+			for (std::size_t i = 0; i < n; i++)
+				func(i);
+		else
+			pool->ChunkedFor(n, chunk, std::forward<Func>(func));
+	}
+}
@@ -8,7 +8,7 @@
 #include <QtCharts/QLineSeries>
 
 #include "opt-methods/solvers/IterationalSolver.hpp"
-#include "opt-methods/solvers/Erased.hpp"
+#include "opt-methods/solvers/Variant.hpp"
 #include "opt-methods/approximators/all.hpp"
 #include "opt-methods/solvers/BaseApproximatorDraw.hpp"
 
@@ -35,12 +35,22 @@ public slots:
 	void powChanged(int);
 
 private:
-	using Approx = ErasedApproximator<double, double>;
+	template<typename P, typename V>
+	using FibonacciSizeTApproximator = FibonacciApproximator<P, V>; // for MSVC to match template template-parameter
+
+	using Approx = VariantApproximator<double, double,
+	                                   DichotomyApproximator<double, double>,
+	                                   FibonacciSizeTApproximator<double, double>,
+	                                   GoldenSectionApproximator<double, double>,
+	                                   ParabolicApproximator<double, double>,
+	                                   BrentApproximator<double, double>,
+	                                   KSectionApproximator<double, double>>;
 	using Solver = IterationalSolver<double, double, Approx>;
 
 	std::optional<Solver> approx{};
 
-	std::function<double (double)> func = [](double x) { return std::pow(x, 4) - 1.5 * atan(x); };
+	// concrete type so that approximators call it directly
+	static constexpr auto func = [](double x) { return std::pow(x, 4) - 1.5 * atan(x); };
 	RangeBounds<double> r = RangeBounds<double>(-1, 1);
 	Solver::SolveData data;
 	QtCharts::QLineSeries* plot = nullptr;
@@ -64,14 +74,12 @@ private:
 		return {getFactory<Approxs<double, double>>()...};
 	}
 
-	template<typename P, typename V>
-	using FibonacciSizeTApproximator = FibonacciApproximator<P, V>; // for MSVC to match template template-parameter
-
 	static inline std::vector<FactoryT> factories = getFactories<DichotomyApproximator,
 																															 FibonacciSizeTApproximator,
 																															 GoldenSectionApproximator,
 																															 ParabolicApproximator,
-																															 BrentApproximator>();
+																															 BrentApproximator,
+																															 KSectionApproximator>();
 
 	void recalc();
 
@@ -6,11 +6,14 @@
 #include <QtCharts/QLegendMarker>
 #include <QGraphicsItem>
 
-#include "opt-methods/solvers/Erased.hpp"
+#include "opt-methods/solvers/Variant.hpp"
 #include "opt-methods/math/BisquareFunction.hpp"
 #include "opt-methods/solvers/IterationalSolver.hpp"
 
 #include "opt-methods/approximators/all.hpp"
+#include "opt-methods/multidim/all.hpp"
+#include "opt-methods/newton/all.hpp"
+#include "opt-methods/quasi-newton/all.hpp"
 #include "opt-methods/solvers/BaseApproximatorDraw.hpp"
 
 #include "NavigableChartView.h"
@@ -52,8 +55,24 @@ public slots:
 	void functionChanged(int);
 
 private:
-	using Approx = ErasedApproximator<double, double>;
-	using MApprox = ErasedApproximator<Vector<double>, double>;
+	template<typename P, typename V>
+	using FibonacciSizeTApproximator = FibonacciApproximator<P, V>; // for MSVC to match template template-parameter
+
+	using Approx = VariantApproximator<double, double,
+	                                   DichotomyApproximator<double, double>,
+	                                   FibonacciSizeTApproximator<double, double>,
+	                                   GoldenSectionApproximator<double, double>,
+	                                   ParabolicApproximator<double, double>,
+	                                   BrentApproximator<double, double>>;
+	using MApprox = VariantApproximator<Vector<double>, double,
+	                                    GradientDescent<Vector<double>, double>,
+	                                    SteepestDescent<Vector<double>, double, Approx>,
+	                                    ConjugateGradientDescent<Vector<double>, double>,
+	                                    Newton<Vector<double>, double>,
+	                                    NewtonOnedim<Vector<double>, double, Approx>,
+	                                    NewtonDirection<Vector<double>, double, Approx>,
+	                                    QuasiNewtonBFS<Vector<double>, double, Approx>,
+	                                    QuasiNewtonPowell<Vector<double>, double, Approx>>;
 
 	std::map<std::string, QCheckBox*> gradientTogglers;
 
@@ -114,9 +133,6 @@ private:
 		return { getFactory<Approxs<double, double>>()... };
 	}
 
-	template<typename P, typename V>
-	using FibonacciSizeTApproximator = FibonacciApproximator<P, V>; // for MSVC to match template template-parameter
-
 	void addVisual(QuadraticFunction2d<double> const& func, MApprox& approx, Vector<double> start,
 								 std::vector<std::pair<double, std::string>>& pointZts, QColor color);
 
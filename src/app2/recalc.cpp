@@ -1,9 +1,6 @@
 #include "ui_mainwindow.h"
 #include "./mainwindow.h"
 
-#include "opt-methods/multidim/all.hpp"
-#include "opt-methods/newton/all.hpp"
-#include "opt-methods/quasi-newton/all.hpp"
 #include "opt-methods/util/Charting.hpp"
 
 #include <QCheckBox>
@@ -65,18 +62,18 @@ void MainWindow::recalc()
 
 	chart = new QChart();
 
-	auto erasedProvider = [&]() { return factories[onedimIndex].first(eps); };
+	auto onedimProvider = [&]() { return factories[onedimIndex].first(eps); };
 	std::vector<std::pair<double, std::string>> levels;
 	{
 		auto desc = MApprox(typeTag<GradientDescent<Vector<double>, double>>, eps);
 		addVisual(bifunc, desc, start, levels, QColor("red"));
 	}
 	{
-		auto desc = MApprox(typeTag<SteepestDescent<Vector<double>, double, ErasedApproximator<double, double>>>, eps, erasedProvider());
+		auto desc = MApprox(typeTag<SteepestDescent<Vector<double>, double, Approx>>, eps, onedimProvider());
 		addVisual(bifunc, desc, start, levels, QColor("darkgreen"));
 	}
 	{
-		auto desc = MApprox(typeTag<ConjugateGradientDescent<Vector<double>, double, QuadraticFunction2d<double>>>, eps);
+		auto desc = MApprox(typeTag<ConjugateGradientDescent<Vector<double>, double>>, eps);
 		addVisual(bifunc, desc, start, levels, QColor("blue"));
 	}
 	{
@@ -84,19 +81,19 @@ void MainWindow::recalc()
 		addVisual(bifunc, desc, start, levels, QColor("cyan"));
 	}
 	{
-		auto desc = MApprox(typeTag<NewtonOnedim<Vector<double>, double, ErasedApproximator<double, double>>>, std::make_tuple(eps, erasedProvider()));
+		auto desc = MApprox(typeTag<NewtonOnedim<Vector<double>, double, Approx>>, std::make_tuple(eps, onedimProvider()));
 		addVisual(bifunc, desc, start, levels, QColor("magenta"));
 	}
 	{
-		auto desc = MApprox(typeTag<NewtonDirection<Vector<double>, double, ErasedApproximator<double, double>>>, std::make_tuple(eps, erasedProvider()));
+		auto desc = MApprox(typeTag<NewtonDirection<Vector<double>, double, Approx>>, std::make_tuple(eps, onedimProvider()));
 		addVisual(bifunc, desc, start, levels, QColor("gray"));
 	}
 	{
-		auto desc = MApprox(typeTag<QuasiNewtonBFS<Vector<double>, double, ErasedApproximator<double, double>>>, std::make_tuple(eps, erasedProvider()));
+		auto desc = MApprox(typeTag<QuasiNewtonBFS<Vector<double>, double, Approx>>, std::make_tuple(eps, onedimProvider()));
 		addVisual(bifunc, desc, start, levels, QColor("gainsboro"));
 	}
 	{
-		auto desc = MApprox(typeTag<QuasiNewtonPowell<Vector<double>, double, ErasedApproximator<double, double>>>, std::make_tuple(eps, erasedProvider()));
+		auto desc = MApprox(typeTag<QuasiNewtonPowell<Vector<double>, double, Approx>>, std::make_tuple(eps, onedimProvider()));
 		addVisual(bifunc, desc, start, levels, QColor("orchid"));
 	}
 
@@ -22,18 +22,34 @@ int main(int argc, char* argv[])
 
 	std::cout << std::setprecision(std::numeric_limits<double>::digits10 + 1);
 
-	int calculationsCount;
+	int calculationsCount, derivativeCalculationsCount;
 
-	auto func = [&calculationsCount](double x) {
-		calculationsCount++;
-		return std::pow(x, 4) - 1.5 * atan(x);
-	};
+	struct CountingFunction
+	{
+		int& calls;
+		int& derivativeCalls;
+
+		double operator()(double x) const
+		{
+			calls++;
+			return std::pow(x, 4) - 1.5 * atan(x);
+		}
+
+		auto grad() const
+		{
+			return [&derivativeCalls = derivativeCalls](double x) {
+				derivativeCalls++;
+				return 4 * std::pow(x, 3) - 1.5 / (1 + x * x);
+			};
+		}
+	} func{calculationsCount, derivativeCalculationsCount};
 
 	constexpr double EPSILON = 1e-7;
 
 	struct IterationInfo
 	{
 		int functionCalls = -1;
+		int derivativeCalls = -1;
 		int iterations = -1;
 		double range = -1;
 	};
@@ -47,24 +63,28 @@ int main(int argc, char* argv[])
 					GoldenSectionApproximator<double, double>,
 					FibonacciApproximator<double, double>,
 					ParabolicApproximator<double, double>,
-					BrentApproximator<double, double>
+					BrentApproximator<double, double>,
+					DBrentApproximator<double, double>
 				>
 			(
 				std::make_tuple(epsilon),
 				std::make_tuple(epsilon),
 				std::make_tuple(epsilon),
 				std::make_tuple(epsilon),
+				std::make_tuple(epsilon),
 				std::make_tuple(epsilon)
 			);
 
 		auto walker =  [&](auto& approx, RangeBounds<double> const& r) {
 			calculationsCount = 0;
+			derivativeCalculationsCount = 0;
 			typename std::decay_t<decltype(approx)>::SolveData dummy;
 			auto result = approx.solveDiff(func, epsilon, r, dummy);
 			std::string name = approx.approximator.name();
 			std::replace(name.begin(), name.end(), ' ', '-');
 			auto& info = iterations[epsilon][name];
 			info.functionCalls = calculationsCount;
+			info.derivativeCalls = derivativeCalculationsCount;
 			info.iterations = (int)dummy.size();
 			info.range = 2 * result.r;
 			names.emplace(name);
@@ -94,6 +114,8 @@ int main(int argc, char* argv[])
 	};
 	cout = std::ofstream(prefix + "/epsilonToComplexity.tsv");
 	complexityPrinter([](auto const& a) { return a.functionCalls; });
+	cout = std::ofstream(prefix + "/epsilonToDerivativeCalls.tsv");
+	complexityPrinter([](auto const& a) { return a.derivativeCalls; });
 	cout = std::ofstream(prefix + "/epsilonToIterations.tsv");
 	complexityPrinter([](auto const& a) { return a.iterations; });
 
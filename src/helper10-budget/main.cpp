@@ -0,0 +1,88 @@
+#include "opt-methods/approximators/all.hpp"
+#include "opt-methods/newton/all.hpp"
+#include "opt-methods/multidim/all.hpp"
+#include "opt-methods/solvers/BudgetedSolver.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * runs BudgetedSolver on Rosenbrock function with every kind of limit,
+ * checks that run stops for expected reason, right after limit is reached
+ */
+namespace
+{
+	using S = double;
+	using V = S;
+	using P = Vector<S>;
+
+	struct Rosenbrock
+	{
+		V operator()(P const& x) const { return 100 * square(x[1] - square(x[0])) + square(1 - x[0]); }
+
+		auto grad() const
+		{
+			return [](P const& x) -> P { return {2 * (200 * cube(x[0]) - 200 * x[0] * x[1] + x[0] - 1), 200 * (x[1] - square(x[0]))}; };
+		}
+
+		auto hessian() const
+		{
+			return [](P const& x) { return DenseMatrix<S>(2, {-400 * (x[1] - square(x[0])) + 800 * square(x[0]) + 2, -400 * x[0], -400 * x[0], 200}); };
+		}
+	};
+
+	/**
+	 * @param used -- counter limited by budget, it is checked to be at least limit and to exceed it by no more than slack,
+	 * which is the most one iteration may use
+	 */
+	template<Approximator<P, V> Approx>
+	bool Check(Approx const& approx, Budget const& budget, TerminationReason expected,
+	           std::size_t BudgetedResult<P, V>::* used = nullptr, std::size_t limit = 0, std::size_t slack = 0)
+	{
+		auto res = BudgetedSolver<P, V, Approx>(approx).solve(Rosenbrock{}, {P{-1.2, 1.}, 1}, budget);
+		std::cout << approx.name() << '\t' << ToString(expected) << '\t' << ToString(res.reason) << '\t'
+		          << res.iterations << '\t' << res.evaluations << '\t' << res.gradients << '\t' << res.hessians << '\n';
+
+		bool ok = res.reason == expected;
+		if (used != nullptr)
+			ok &= res.*used >= limit && res.*used <= limit + slack;
+		// best is evaluated point with its own value
+		if (res.evaluations > 0)
+			ok &= res.best.has_value() && res.best->v == Rosenbrock{}(res.best->p);
+		if (!ok)
+			std::cerr << approx.name() << ": expected to stop by " << ToString(expected) << std::endl;
+		return ok;
+	}
+
+	Budget With(std::size_t Budget::* field, std::size_t limit)
+	{
+		Budget res;
+		res.*field = limit;
+		return res;
+	}
+}
+
+int main()
+{
+	std::cout << "method\texpected\treason\titerations\tevaluations\tgradients\thessians\n";
+
+	using Onedim = BrentApproximator<S, V>;
+	auto newton = Newton<P, V>(1e-5);
+	auto steepest = SteepestDescent<P, V, Onedim>(1e-5, Onedim(1e-7));
+	auto gradient = GradientDescent<P, V>(1e-5);
+
+	bool ok = true;
+	ok &= Check(newton, {}, TerminationReason::Finished);
+	// brent takes at most few dozens of evaluations on one line
+	ok &= Check(steepest, With(&Budget::evaluations, 1000), TerminationReason::Evaluations, &BudgetedResult<P, V>::evaluations, 1000, 100);
+	// one gradient per iteration
+	ok &= Check(gradient, With(&Budget::gradients, 100), TerminationReason::Gradients, &BudgetedResult<P, V>::gradients, 100, 0);
+	// one hessian per iteration
+	ok &= Check(newton, With(&Budget::hessians, 5), TerminationReason::Hessians, &BudgetedResult<P, V>::hessians, 5, 0);
+	ok &= Check(steepest, With(&Budget::iterations, 50), TerminationReason::Iterations, &BudgetedResult<P, V>::iterations, 50, 0);
+	// steepest descent needs much more than millisecond on Rosenbrock function
+	ok &= Check(steepest, Budget::Within(std::chrono::milliseconds(1)), TerminationReason::Deadline);
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
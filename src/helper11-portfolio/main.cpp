@@ -0,0 +1,52 @@
+#include "opt-methods/approximators/all.hpp"
+#include "opt-methods/solvers/PortfolioSolver.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * checks which method of portfolio wins: method stopping with region wider than tolerance must not win,
+ * methods run one after another, so without pool the first converging one is the winner
+ */
+namespace
+{
+	using S = double;
+
+	template<typename Portfolio>
+	bool Check(char const* title, Portfolio const& portfolio, typename Portfolio::Options const& options,
+	           std::size_t winner, std::vector<PortfolioOutcome> const& outcomes)
+	{
+		auto func = [](S x) { return std::pow(x, 4) - 1.5 * std::atan(x); };
+		auto res = portfolio.solve(func, {-1., 1., bound_tag}, options);
+
+		bool ok = res.winner == winner;
+		std::cout << title << '\n';
+		for (std::size_t i = 0; i < res.methods.size(); i++)
+		{
+			auto const& m = res.methods[i];
+			std::cout << '\t' << m.name << '\t' << ToString(m.outcome) << '\t' << m.iterations << '\t' << m.evaluations << '\n';
+			ok &= m.outcome == outcomes[i];
+		}
+		if (!ok)
+			std::cerr << title << ": unexpected winner or outcomes" << std::endl;
+		return ok;
+	}
+}
+
+int main()
+{
+	using Loose = DichotomyApproximator<S, S>;
+	using Tight = BrentApproximator<S, S>;
+	PortfolioSolver<S, S, Loose, Tight> portfolio(nullptr, Loose(1e-2), Tight(1e-8));
+
+	bool ok = true;
+	// dichotomy ends with region about 1e-2 wide, so brent wins
+	ok &= Check("tolerance", portfolio, {.tolerance = 1e-6}, 1, {PortfolioOutcome::Stopped, PortfolioOutcome::Converged});
+	// both would stop within tolerance, first one wins
+	ok &= Check("loose tolerance", portfolio, {.tolerance = 1}, 0, {PortfolioOutcome::Converged, PortfolioOutcome::Cancelled});
+	// value near start point is reached by first iterations of dichotomy
+	ok &= Check("target", portfolio, {.target = 0, .tolerance = 1e-6}, 0, {PortfolioOutcome::Converged, PortfolioOutcome::Cancelled});
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
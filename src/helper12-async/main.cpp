@@ -0,0 +1,84 @@
+#include "opt-methods/approximators/all.hpp"
+#include "opt-methods/solvers/AsyncScheduler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/**
+ * runs many dichotomy and k-section searches of slow function on one scheduler thread,
+ * evaluations go to thread pool; each result must be the same as of synchronous run with plain function
+ */
+namespace
+{
+	using S = double;
+
+	constexpr std::size_t RUNS = 100;
+	constexpr std::size_t THREADS = 8;
+	constexpr auto DELAY = std::chrono::milliseconds(2);
+
+	S Parabola(S x) { return (x - 0.3) * (x - 0.3); }
+
+	template<typename Approx, typename F>
+	PointRegion<S> Last(Approx const& approx, F const& func, PointRegion<S> const& region)
+	{
+		PointRegion<S> last = region;
+		auto gen = approx(func, region);
+		while (gen.next())
+			last = gen.getValue();
+		return last;
+	}
+}
+
+int main()
+{
+	auto pool = std::make_shared<util::ThreadPool>(THREADS);
+	std::atomic<std::size_t> calls = 0;
+	auto slow = [&](S x) {
+		calls++;
+		std::this_thread::sleep_for(DELAY);
+		return Parabola(x);
+	};
+	AsyncFunction<S, S, decltype(slow)> async(slow, pool);
+
+	DichotomyApproximator<S, S> dichotomy(1e-6);
+	KSectionApproximator<S, S> ksection(1e-6, 4);
+	auto region = [](std::size_t i) { return PointRegion<S>{-1. - S(i), 1. + S(i), bound_tag}; };
+
+	bool ok = true;
+
+	// synchronous caller waits for pending evaluations itself
+	if (auto a = Last(dichotomy, async, region(0)), s = Last(dichotomy, Parabola, region(0)); a.p != s.p || a.r != s.r)
+	{
+		std::cerr << "synchronous run with async function differs" << std::endl;
+		ok = false;
+	}
+
+	AsyncScheduler<S, S> scheduler;
+	std::vector<PointRegion<S>> results(RUNS, PointRegion<S>{0, 0});
+	calls = 0;
+	auto begin = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < RUNS; i++)
+		scheduler.add(i % 2 == 0 ? ksection(async, region(i)) : dichotomy(async, region(i)),
+		              [&, i](PointRegion<S> const& r) { results[i] = r; });
+	scheduler.run();
+	std::chrono::duration<double> spent = std::chrono::steady_clock::now() - begin;
+	std::chrono::duration<double> serial = DELAY * calls.load();
+
+	std::cout << "runs\t" << RUNS << "\npool threads\t" << THREADS << "\ncalls\t" << calls << "\nseconds\t" << spent.count()
+	          << "\nserial seconds\t" << serial.count() << '\n';
+
+	for (std::size_t i = 0; i < RUNS; i++)
+	{
+		auto expected = i % 2 == 0 ? Last(ksection, Parabola, region(i)) : Last(dichotomy, Parabola, region(i));
+		if (results[i].p != expected.p || results[i].r != expected.r)
+		{
+			std::cerr << "run " << i << " differs from synchronous one" << std::endl;
+			ok = false;
+		}
+	}
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,85 @@
+#include "opt-methods/approximators/all.hpp"
+#include "opt-methods/multidim/all.hpp"
+#include "opt-methods/newton/all.hpp"
+#include "opt-methods/quasi-newton/all.hpp"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+/**
+ * compares exact line search (brent) with inexact ones on Rosenbrock function from (-1.2, 1):
+ * prints outer iterations, evaluations and evaluations per outer step,
+ * checks that minimum is reached with inexact searches, brent rows are for comparison only
+ */
+namespace
+{
+	using S = double;
+	using V = S;
+	using P = Vector<S>;
+
+	constexpr std::size_t ITERATIONS_LIMIT = 100'000;
+
+	struct Rosenbrock
+	{
+		V operator()(P const& x) const { return 100 * square(x[1] - square(x[0])) + square(1 - x[0]); }
+
+		auto grad() const
+		{
+			return [](P const& x) -> P { return {2 * (200 * cube(x[0]) - 200 * x[0] * x[1] + x[0] - 1), 200 * (x[1] - square(x[0]))}; };
+		}
+
+		auto hessian() const
+		{
+			return [](P const& x) { return DenseMatrix<S>(2, {-400 * (x[1] - square(x[0])) + 800 * square(x[0]) + 2, -400 * x[0], -400 * x[0], 200}); };
+		}
+	};
+
+	bool Report(Approximator<P, V> auto const& approx, char const* search, bool check)
+	{
+		EvaluationCounters counters;
+		P last{-1.2, 1.};
+		std::size_t iterations = 0;
+		auto gen = approx(impl::CountingFunction<P, V, Rosenbrock>({}, counters), PointRegion<P>{last, 1});
+		while (iterations < ITERATIONS_LIMIT && gen.next())
+		{
+			last = gen.getValue().p;
+			iterations++;
+		}
+		auto perStep = [&](std::size_t n) { return iterations == 0 ? 0. : double(n) / double(iterations); };
+		std::cout << approx.name() << '\t' << search << '\t' << iterations << '\t' << counters.evaluations << '\t' << counters.gradients
+		          << '\t' << perStep(counters.evaluations) << '\t' << perStep(counters.gradients) << '\t' << Rosenbrock{}(last) << '\n';
+
+		if (check && (iterations >= ITERATIONS_LIMIT || Rosenbrock{}(last) > 1e-6))
+		{
+			std::cerr << approx.name() << " with " << search << ": minimum is not reached" << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	template<typename Search>
+	bool ReportAll(Search const& search, bool check = true)
+	{
+		bool ok = true;
+		ok &= Report(SteepestDescent<P, V, Search>(1e-5, search), search.name(), check);
+		ok &= Report(NewtonOnedim<P, V, Search>(std::make_tuple(1e-5, search)), search.name(), check);
+		ok &= Report(QuasiNewtonBFS<P, V, Search>(std::make_tuple(1e-5, search)), search.name(), check);
+		return ok;
+	}
+}
+
+int main()
+{
+	std::cout << std::setprecision(4);
+	std::cout << "method\tline search\titerations\tcalls\tgradients\tcalls per step\tgradients per step\tfinal value\n";
+
+	bool ok = true;
+	// bfs quits as soon as its step is shorter than sqrt(epsilon), exact search makes it stop after 2 steps
+	ok &= ReportAll(BrentApproximator<S, V>(1e-7), false);
+	ok &= ReportAll(ArmijoLineSearch<S, V>());
+	ok &= ReportAll(WolfeLineSearch<S, V>());
+	ok &= ReportAll(HagerZhangLineSearch<S, V>());
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
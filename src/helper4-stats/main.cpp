@@ -8,6 +8,7 @@
 #include "opt-methods/solvers/Erased.hpp"
 
 #include "opt-methods/math/BisquareFunction.hpp"
+#include "opt-methods/math/Expression.hpp"
 
 #include <array>
 #include <tuple>
@@ -146,6 +147,23 @@ struct Nop
 
 inline constexpr Nop nop;
 
+template<typename P, typename V>
+P const& TrajPoint(IterationDataBuffer<P, V> const& info, std::size_t i)
+{
+	return info[i].second.p;
+}
+
+template<typename P>
+P TrajPoint(ColumnarRecorder<P> const& info, std::size_t i)
+{
+	auto p = info.point(i);
+	return P(p.data(), p.size());
+}
+
+/**
+ * @param info -- SolveData when actions need iteration data, ColumnarRecorder otherwise:
+ * about 1000 rows are printed, stride depends on final number of iterations, so all points are kept
+ */
 auto SolveAndPrintTraj(std::filesystem::path const& dir, std::string const& name, auto const& approx, auto const& func, auto const& pt, auto& info)
 {
 	namespace fs = std::filesystem;
@@ -156,8 +174,8 @@ auto SolveAndPrintTraj(std::filesystem::path const& dir, std::string const& name
 	const auto nth = std::max((std::size_t)1, info.size() / 1000);
 	for (std::size_t ii = 0; ii < info.size(); ii += nth)
 	{
-		auto const& i = info[ii];
-		PrintJoined(cout, '\t', i.second.p) << '\t' << func(i.second.p) << '\n';
+		auto const& p = TrajPoint(info, ii);
+		PrintJoined(cout, '\t', p) << '\t' << func(p) << '\n';
 	}
 	decltype(ret.p) ans;
 	ans.resize(ret.p.size() + 1);
@@ -187,7 +205,10 @@ auto TestSolversFuncsPts(
 
 		    auto dir = localPrefix / std::to_string(fi + fOff) / std::to_string(pti + pOff);
 
-		    typename std::decay_t<decltype(approx)>::SolveData info;
+		    using Recorder = std::conditional_t<std::is_same_v<std::remove_cvref_t<Action>, Nop>,
+		                                        ColumnarRecorder<Pt>,
+		                                        typename std::decay_t<decltype(approx)>::SolveData>;
+		    Recorder info;
 		    auto lastPoint = SolveAndPrintTraj(dir, name, approx, func, pt, info);
 
 		    actions(fi, pti, name, dir, approx, func, pt, info);
@@ -344,20 +365,10 @@ int main(int argc, char* argv[])
 			auto localPrefix = prefix / "1.1";
 			std::tuple funcs = {
 			    QuadraticFunction2d<S>(8, 1, 1, 0, 0, -1),
-			    adHocFunction(
-			        [](P x) -> V { return -std::exp(-Len2(x)) + square(x[0]) + 2 * square(x[1]); },
-			        [](P x) -> Vector<S> {
-				        return {2 * x[0] * std::exp(-Len2(x)) + 2 * x[0],
-				                2 * x[1] * std::exp(-Len2(x)) + 4 * x[1]};
-			        },
-			        [](P x) {
-				        return DenseMatrix<S>(
-				            2,
-				            {-4 * square(x[0]) * std::exp(-Len2(x)) + 2 * std::exp(-Len2(x)) + 2,
-				             -4 * x[0] * x[1] * std::exp(-Len2(x)),
-				             -4 * x[0] * x[1] * std::exp(-Len2(x)),
-				             -4 * square(x[1]) * std::exp(-Len2(x)) + 2 * std::exp(-Len2(x)) + 4});
-			        })
+			    [] {
+				    using expr::x, expr::c;
+				    return Symbolic<S>(-exp(-(square(x<0>) + square(x<1>))) + square(x<0>) + c<2> * square(x<1>));
+			    }()
 			};
 
 			std::tuple pts = {P{0.5, 0.5}, P{1., 1.}, P{3., 3.}};
@@ -421,7 +432,7 @@ int main(int argc, char* argv[])
 				    fs::create_directories(dir);
 				    auto cout = std::ofstream(dir / (name + "Traj.tsv"));
 
-				    typename std::decay_t<decltype(approx)>::SolveData info;
+				    ColumnarRecorder<std::remove_cvref_t<decltype(pt)>> info;
 				    SolveAndPrintTraj(dir, name, approx, func, pt, info);
 
 				    iterations[fi][name] = (int)info.size();
@@ -479,32 +490,11 @@ int main(int argc, char* argv[])
 				                                         4 * (x[0] + x[1]),
 				                                         4 * (x[0] + square(x[1]) - 7) + 8 * square(x[1]) + 2});
 			                  }),
-			    flatAdHocFunction<S, 2>(
-			        [](S x, S y) -> V {
-				        return 100 - 2 / (1 + square((x - 1) / 2) + square((y - 1) / 3)) -
-				               1 / (1 + square((x - 2) / 2) + square((y - 1) / 3));
-			        },
-			        [](S x, S y) -> Vector<S> {
-				        return {(-2 + x) / (2 * square(1 + square(-2 + x) / 4 + square(-1 + y) / 9)) +
-				                    (-1 + x) / square(1 + square(-1 + x) / 4 + square(-1 + y) / 9),
-				                (2 * (-1 + y)) / (9 * square(1 + square(-2 + x) / 4 + square(-1 + y) / 9)) +
-				                    (4 * (-1 + y)) / (9 * square(1 + square(-1 + x) / 4 + square(-1 + y) / 9))};
-			        },
-			        [](S x, S y) -> DenseMatrix<S> {
-				        return {2,
-				                {-square(-2 + x) / (2 * cube(1 + square(-2 + x) / 4 + square(-1 + y) / 9)) +
-				                     1 / (2 * square(1 + square(-2 + x) / 4 + square(-1 + y) / 9)) -
-				                     square(-1 + x) / cube(1 + square(-1 + x) / 4 + square(-1 + y) / 9) +
-				                     1 / square(1 + square(-1 + x) / 4 + square(-1 + y) / 9),
-				                 (-2 * (-2 + x) * (-1 + y)) / (9 * cube(1 + square(-2 + x) / 4 + square(-1 + y) / 9)) -
-				                     (4 * (-1 + x) * (-1 + y)) / (9 * cube(1 + square(-1 + x) / 4 + square(-1 + y) / 9)),
-				                 (-2 * (-2 + x) * (-1 + y)) / (9 * cube(1 + square(-2 + x) / 4 + square(-1 + y) / 9)) -
-				                     (4 * (-1 + x) * (-1 + y)) / (9 * cube(1 + square(-1 + x) / 4 + square(-1 + y) / 9)),
-				                 2 / (9 * square(1 + square(-2 + x) / 4 + square(-1 + y) / 9)) +
-				                     4 / (9 * square(1 + square(-1 + x) / 4 + square(-1 + y) / 9)) -
-				                     (8 * square(-1 + y)) / (81 * cube(1 + square(-2 + x) / 4 + square(-1 + y) / 9)) -
-				                     (16 * square(-1 + y)) / (81 * cube(1 + square(-1 + x) / 4 + square(-1 + y) / 9))}};
-			        })
+			    [] {
+				    using expr::x, expr::c;
+				    return Symbolic<S>(c<100> - c<2> / (c<1> + square((x<0> - c<1>) / c<2>) + square((x<1> - c<1>) / c<3>)) -
+				                       c<1> / (c<1> + square((x<0> - c<2>) / c<2>) + square((x<1> - c<1>) / c<3>)));
+			    }()
 			};
 			std::tuple funcs4 = {
 			    flatAdHocFunction<S, 4>(
@@ -549,7 +539,7 @@ int main(int argc, char* argv[])
 			                    solvers,
 			                    funcs4,
 			                    pts4,
-			                    [](...) {}, impl::tuple_size_v<decltype(funcs2)>);
+			                    nop, impl::tuple_size_v<decltype(funcs2)>);
 		}
 
 		{
@@ -0,0 +1,190 @@
+#include "opt-methods/approximators/all.hpp"
+#include "opt-methods/multidim/all.hpp"
+#include "opt-methods/newton/all.hpp"
+#include "opt-methods/math/BisquareFunction.hpp"
+#include "opt-methods/math/Expression.hpp"
+#include "opt-methods/quasi-newton/all.hpp"
+#include "opt-methods/solvers/IterationalSolver.hpp"
+#include "opt-methods/solvers/Variant.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+/**
+ * compares coroutine execution (generator resumed on each iteration) with direct loop of the same approximator,
+ * approximators without direct mode are run to the end by impl::Minimize, which must return the same last region,
+ * then checks that minimize() of VariantApproximator agrees with its coroutine for every method of app1 and app2
+ * and that FinalOnly recorder keeps region returned by solver when it is stopped after any number of iterations
+ */
+namespace
+{
+	template<typename Run>
+	double NanosecondsPerRun(std::size_t runs, Run&& run)
+	{
+		volatile double sink = 0;
+		auto start = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < runs; i++)
+			sink = sink + run(i);
+		std::chrono::duration<double, std::nano> spent = std::chrono::steady_clock::now() - start;
+		return spent.count() / static_cast<double>(runs);
+	}
+
+	template<typename P, typename V, typename Approx, typename F>
+	bool Compare(std::string const& name, Approx const& approx, F const& func, PointRegion<P> const& region, std::size_t runs, auto&& first)
+	{
+		auto viaCoroutine = [&](std::size_t) {
+			auto gen = approx(func, region);
+			PointRegion<P> last = region;
+			while (gen.next())
+				last = gen.getValue();
+			return first(last.p);
+		};
+		auto direct = [&](std::size_t) { return first(impl::Minimize<P, V>(approx, func, region).value_or(region).p); };
+
+		// warm up, also checks that both modes agree
+		if (viaCoroutine(0) != direct(0))
+		{
+			std::cerr << name << ": modes disagree" << std::endl;
+			return false;
+		}
+
+		double c = NanosecondsPerRun(runs, viaCoroutine), d = NanosecondsPerRun(runs, direct);
+		std::cout << name << '\t' << c << '\t' << d << '\t' << c / d << '\n';
+		return true;
+	}
+
+	template<typename P>
+	bool SameRegion(std::optional<PointRegion<P>> const& a, std::optional<PointRegion<P>> const& b)
+	{
+		if (!a || !b)
+			return a.has_value() == b.has_value();
+		if constexpr (std::floating_point<P>)
+			return a->p == b->p && a->r == b->r;
+		else
+			return std::ranges::equal(a->p, b->p) && a->r == b->r;
+	}
+
+	/// minimize() of variant must return last region yielded by its coroutine
+	template<typename VA, typename F>
+	bool CheckVariant(std::string const& name, VA const& approx, F const& func, PointRegion<typename VA::P> const& region)
+	{
+		std::optional<PointRegion<typename VA::P>> last;
+		auto gen = approx(func, region);
+		while (gen.next())
+			last = gen.getValue();
+		if (SameRegion(last, approx.minimize(func, region)))
+			return true;
+		std::cerr << name << ": variant minimize() differs from coroutine" << std::endl;
+		return false;
+	}
+
+	template<typename P, typename V>
+	using FibonacciSizeTApproximator = FibonacciApproximator<P, V>;
+
+	// lists of methods as in app1 and app2
+	using Approx = VariantApproximator<double, double,
+	                                   DichotomyApproximator<double, double>,
+	                                   FibonacciSizeTApproximator<double, double>,
+	                                   GoldenSectionApproximator<double, double>,
+	                                   ParabolicApproximator<double, double>,
+	                                   BrentApproximator<double, double>,
+	                                   KSectionApproximator<double, double>>;
+	using MApprox = VariantApproximator<Vector<double>, double,
+	                                    GradientDescent<Vector<double>, double>,
+	                                    SteepestDescent<Vector<double>, double, Approx>,
+	                                    ConjugateGradientDescent<Vector<double>, double>,
+	                                    Newton<Vector<double>, double>,
+	                                    NewtonOnedim<Vector<double>, double, Approx>,
+	                                    NewtonDirection<Vector<double>, double, Approx>,
+	                                    QuasiNewtonBFS<Vector<double>, double, Approx>,
+	                                    QuasiNewtonPowell<Vector<double>, double, Approx>>;
+
+	template<typename... A>
+	std::vector<Approx> OnedimMethods(double eps)
+	{
+		return {Approx(typeTag<A>, eps)...};
+	}
+
+	template<typename P, typename V, typename Approx, typename F>
+	bool CheckFinalOnly(std::string const& name, Approx const& approx, F const& func, PointRegion<P> const& region)
+	{
+		IterationalSolver<P, V, Approx> solver(approx);
+		for (std::size_t n : {1, 2, 5, 20, 1'000'000})
+		{
+			FinalOnly<P> final;
+			auto res = solver.solveIteration(func, n, region, final);
+			if (!SameRegion(std::optional(res), final.last))
+			{
+				std::cerr << name << ": FinalOnly differs from region returned after " << n << " iterations" << std::endl;
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool CheckVariants()
+	{
+		using P = Vector<double>;
+		bool ok = true;
+		auto onedim = [](double x) { return std::pow(x, 4) - 1.5 * atan(x); };
+		auto onedims = OnedimMethods<DichotomyApproximator<double, double>,
+		                             FibonacciSizeTApproximator<double, double>,
+		                             GoldenSectionApproximator<double, double>,
+		                             ParabolicApproximator<double, double>,
+		                             BrentApproximator<double, double>,
+		                             KSectionApproximator<double, double>>(1e-7);
+		for (auto const& a : onedims)
+			ok &= CheckVariant(a.name(), a, onedim, {-1., 1., bound_tag});
+
+		// first function of app2
+		auto quadratic = QuadraticFunction2d<double>(2.5, 3, 4, 0.1, -0.5, 10);
+		PointRegion<P> start{P{3., 4.}, 10};
+		double eps = 1e-3;
+		ok &= CheckVariant("gradient descent", MApprox(typeTag<GradientDescent<P, double>>, eps), quadratic, start);
+		ok &= CheckVariant("conjugate gradient", MApprox(typeTag<ConjugateGradientDescent<P, double>>, eps), quadratic, start);
+		ok &= CheckVariant("newton", MApprox(typeTag<Newton<P, double>>, eps), quadratic, start);
+		for (auto const& a : onedims)
+		{
+			std::string inner = a.name();
+			ok &= CheckVariant("steepest descent, " + inner, MApprox(typeTag<SteepestDescent<P, double, Approx>>, eps, a), quadratic, start);
+			ok &= CheckVariant("newton onedim, " + inner, MApprox(typeTag<NewtonOnedim<P, double, Approx>>, std::make_tuple(eps, a)), quadratic, start);
+			ok &= CheckVariant("newton direction, " + inner, MApprox(typeTag<NewtonDirection<P, double, Approx>>, std::make_tuple(eps, a)), quadratic, start);
+			ok &= CheckVariant("bfs, " + inner, MApprox(typeTag<QuasiNewtonBFS<P, double, Approx>>, std::make_tuple(eps, a)), quadratic, start);
+			ok &= CheckVariant("powell, " + inner, MApprox(typeTag<QuasiNewtonPowell<P, double, Approx>>, std::make_tuple(eps, a)), quadratic, start);
+		}
+		return ok;
+	}
+}
+
+int main()
+{
+	std::cout << std::setprecision(4);
+	std::cout << "method\tcoroutine ns\tdirect ns\tspeedup\n";
+
+	bool ok = true;
+	auto onedim = [](double x) { return std::pow(x, 4) - 1.5 * atan(x); };
+	auto scalar = [](double x) { return x; };
+	ok &= Compare<double, double>("golden section", GoldenSectionApproximator<double, double>(1e-7), onedim, {-1., 1., bound_tag}, 200'000, scalar);
+	ok &= Compare<double, double>("brent", BrentApproximator<double, double>(1e-7), onedim, {-1., 1., bound_tag}, 200'000, scalar);
+
+	using namespace expr;
+	using P = Vector<double>;
+	auto quadratic = Symbolic<double>(c<8> * square(x<0> - c<1>) + square(x<1> + c<2>) + x<0> * x<1>);
+	auto first = [](P const& p) { return p[0]; };
+	ok &= Compare<P, double>("gradient descent", GradientDescent<P, double>(1e-6), quadratic, {P{10., 10.}, 0.1}, 20'000, first);
+
+	// no direct mode: both columns run coroutine, direct one through impl::Minimize
+	auto quadratic2d = QuadraticFunction2d<double>(64, 126, 64, -10, 30, 13);
+	ok &= Compare<P, double>("newton (no direct mode)", Newton<P, double>(1e-7), quadratic2d, {P{3., 4.}, 10}, 20'000, first);
+
+	ok &= CheckVariants();
+	ok &= CheckFinalOnly<double, double>("brent", BrentApproximator<double, double>(1e-7), onedim, {-1., 1., bound_tag});
+	ok &= CheckFinalOnly<P, double>("newton", Newton<P, double>(1e-7), quadratic2d, {P{3., 4.}, 10});
+	ok &= CheckFinalOnly<P, double>("gradient descent", GradientDescent<P, double>(1e-6), quadratic, {P{10., 10.}, 0.1});
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
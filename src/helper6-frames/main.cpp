@@ -0,0 +1,67 @@
+#include "opt-methods/approximators/all.hpp"
+#include "opt-methods/newton/all.hpp"
+#include "opt-methods/multidim/all.hpp"
+#include "opt-methods/math/BisquareFunction.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * checks that coroutine frames are recycled: after warm up runs no frame is taken from malloc,
+ * including frames of nested one-dimensional approximators created on every outer iteration
+ */
+namespace
+{
+	constexpr std::size_t WARMUP = 3;
+	constexpr std::size_t RUNS = 1000;
+
+	template<typename P, typename V, typename Approx, typename F>
+	bool Check(char const* name, Approx const& approx, F const& func, PointRegion<P> const& region)
+	{
+		auto run = [&] {
+			auto gen = approx(func, region);
+			while (gen.next())
+				;
+		};
+		auto const& stats = util::FramePool::local().stats();
+
+		for (std::size_t i = 0; i < WARMUP; i++)
+			run();
+		auto before = stats;
+		for (std::size_t i = 0; i < RUNS; i++)
+			run();
+
+		std::size_t fresh = stats.allocated - before.allocated;
+		std::cout << name << '\t' << before.allocated << '\t' << fresh << '\t' << stats.reused - before.reused << '\n';
+		return fresh == 0;
+	}
+}
+
+int main()
+{
+	using S = double;
+	using P = Vector<S>;
+
+	std::cout << "method\tallocated after warm up\tallocated in steady state\treused\n";
+
+	auto onedim = [](S x) { return std::pow(x, 4) - 1.5 * std::atan(x); };
+	auto quadratic = QuadraticFunction2d<S>(64, 126, 64, -10, 30, 13);
+	PointRegion<P> start{P{10., 10.}, 1};
+
+	using MApprox = BrentApproximator<S, S>;
+
+	bool ok = true;
+	ok &= Check<S, S>("golden section", GoldenSectionApproximator<S, S>(1e-7), onedim, {-1., 1., bound_tag});
+	ok &= Check<S, S>("brent", MApprox(1e-7), onedim, {-1., 1., bound_tag});
+	ok &= Check<P, S>("gradient descent", GradientDescent<P, S>(1e-5), quadratic, start);
+	ok &= Check<P, S>("steepest descent", SteepestDescent<P, S, MApprox>(1e-5, MApprox(1e-7)), quadratic, start);
+	ok &= Check<P, S>("newton with direction", NewtonDirection<P, S, MApprox>(std::make_tuple(1e-5, MApprox(1e-7))), quadratic, start);
+
+	if (!ok)
+	{
+		std::cerr << "coroutine frames are allocated in steady state" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
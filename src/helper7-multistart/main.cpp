@@ -0,0 +1,72 @@
+#include "opt-methods/multidim/all.hpp"
+#include "opt-methods/solvers/MultiStart.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * checks merging of minima found by multi-start in high dimension:
+ * double wells in first coordinates give 2^wells minima, the rest is quadratic,
+ * box is shifted off saddle points of wells, found minima must not depend on thread count
+ */
+namespace
+{
+	using S = double;
+	using P = Vector<S>;
+
+	constexpr std::size_t DIM = 16;
+	constexpr std::size_t WELLS = 3;
+	constexpr std::size_t STARTS = 256;
+
+	struct Wells
+	{
+		S operator()(P const& x) const
+		{
+			S res = 0;
+			for (std::size_t i = 0; i < x.size(); i++)
+				res += i < WELLS ? square(square(x[i]) - 1) : square(x[i]);
+			return res;
+		}
+
+		auto grad() const
+		{
+			return [](P const& x) {
+				P res(x.size());
+				for (std::size_t i = 0; i < x.size(); i++)
+					res[i] = i < WELLS ? 4 * x[i] * (square(x[i]) - 1) : 2 * x[i];
+				return res;
+			};
+		}
+	};
+
+	std::vector<DistinctMinimum<P, S>> Run(std::shared_ptr<util::ThreadPool> pool)
+	{
+		MultiStart<P, S, GradientDescent<P, S>> ms(GradientDescent<P, S>(1e-9), std::move(pool), 0.1, 1e-3);
+		return ms.solve(Wells{}, HaltonSampler<S>(DIM), STARTS, PointRegion<P>{P(S(0.1), DIM), 2});
+	}
+}
+
+int main()
+{
+	auto begin = std::chrono::steady_clock::now();
+	auto sequential = Run(nullptr);
+	auto pooled = Run(std::make_shared<util::ThreadPool>(4));
+	std::chrono::duration<double> spent = std::chrono::steady_clock::now() - begin;
+
+	std::size_t hits = 0;
+	for (auto const& m : sequential)
+		hits += m.hits;
+	bool same = sequential.size() == pooled.size();
+	for (std::size_t i = 0; same && i < sequential.size(); i++)
+		same = sequential[i].firstStart == pooled[i].firstStart && sequential[i].hits == pooled[i].hits;
+
+	std::cout << "dimension\t" << DIM << "\nstarts\t" << STARTS << "\nminima\t" << sequential.size() << "\nseconds\t" << spent.count() << '\n';
+
+	if (sequential.size() != (std::size_t(1) << WELLS) || hits != STARTS || !same)
+	{
+		std::cerr << "minima are not merged as expected" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+#include "opt-methods/approximators/all.hpp"
+#include "opt-methods/newton/all.hpp"
+#include "opt-methods/multidim/all.hpp"
+#include "opt-methods/marquardt/all.hpp"
+#include "opt-methods/solvers/function/CachedFunction.hpp"
+
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * reports how many evaluations CachedFunction saves on Rosenbrock function,
+ * checks that cache is transparent: cached and plain runs end at the same point
+ */
+namespace
+{
+	using S = double;
+	using V = S;
+	using P = Vector<S>;
+
+	struct Rosenbrock
+	{
+		V operator()(P const& x) const { return 100 * square(x[1] - square(x[0])) + square(1 - x[0]); }
+
+		auto grad() const
+		{
+			return [](P const& x) -> P { return {2 * (200 * cube(x[0]) - 200 * x[0] * x[1] + x[0] - 1), 200 * (x[1] - square(x[0]))}; };
+		}
+
+		auto hessian() const
+		{
+			return [](P const& x) { return DenseMatrix<S>(2, {-400 * (x[1] - square(x[0])) + 800 * square(x[0]) + 2, -400 * x[0], -400 * x[0], 200}); };
+		}
+	};
+
+	template<typename F>
+	std::pair<P, std::size_t> Run(Approximator<P, V> auto const& approx, F const& func)
+	{
+		P last{-1.2, 1.};
+		std::size_t iterations = 0;
+		auto gen = approx(func, PointRegion<P>{last, 1});
+		while (gen.next())
+		{
+			last = gen.getValue().p;
+			iterations++;
+		}
+		return {last, iterations};
+	}
+
+	/// @return number of hits
+	std::size_t Report(Approximator<P, V> auto const& approx)
+	{
+		auto cached = CachedFunction(typeTag<P>, typeTag<V>, Rosenbrock{});
+		auto [plainLast, plainIterations] = Run(approx, Rosenbrock{});
+		auto [last, iterations] = Run(approx, cached);
+
+		std::cout << approx.name() << '\t' << iterations << '\t' << cached.hits() + cached.misses() << '\t' << cached.misses() << '\t' << cached.hits() << '\n';
+		if (iterations != plainIterations || Len2(P(last - plainLast)) != 0)
+		{
+			std::cerr << approx.name() << ": cached run differs from plain one" << std::endl;
+			std::exit(EXIT_FAILURE);
+		}
+		return cached.hits();
+	}
+}
+
+int main()
+{
+	std::cout << "method\titerations\tcalls\tcalls with cache\thits\n";
+
+	using Onedim = BrentApproximator<S, V>;
+
+	// newton evaluates accepted point in step search and again at start of next step
+	std::size_t newtonHits = Report(Newton<P, V>(1e-5));
+	Report(Marquardt1<P, V>(1e-5, 1000, 0.5));
+	Report(SteepestDescent<P, V, Onedim>(1e-5, Onedim(1e-7)));
+	Report(GradientDescent<P, V>(1e-5));
+
+	if (newtonHits == 0)
+	{
+		std::cerr << "no evaluations are saved" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
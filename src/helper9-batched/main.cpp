@@ -0,0 +1,109 @@
+#include "opt-methods/approximators/all.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/**
+ * times bulk one-dimensional minimization: golden section run directly on each interval,
+ * batched golden section with plain function and with function evaluating all lanes at once,
+ * checks that batched results are the same as those of golden section
+ */
+namespace
+{
+	using S = double;
+
+	constexpr std::size_t INTERVALS = 20'000;
+	constexpr std::size_t LANES = 8;
+	constexpr std::size_t RUNS = 5;
+	constexpr S EPSILON = 1e-7;
+
+	using Batch = std::array<S, LANES>;
+
+	template<typename Run>
+	double Milliseconds(Run&& run)
+	{
+		double best = INFINITY;
+		for (std::size_t i = 0; i < RUNS; i++)
+		{
+			auto start = std::chrono::steady_clock::now();
+			run();
+			std::chrono::duration<double, std::milli> spent = std::chrono::steady_clock::now() - start;
+			best = std::min(best, spent.count());
+		}
+		return best;
+	}
+
+	bool Same(std::vector<PointRegion<S>> const& l, std::vector<PointRegion<S>> const& r)
+	{
+		return std::equal(l.begin(), l.end(), r.begin(), r.end(), [](auto const& a, auto const& b) { return a.p == b.p && a.r == b.r; });
+	}
+
+	/**
+	 * @param batch -- same function evaluating LANES points
+	 * @return false if results differ
+	 */
+	bool Compare(char const* name, auto const& func, auto const& batch, std::vector<PointRegion<S>> const& regions)
+	{
+		GoldenSectionApproximator<S, S> scalar(EPSILON);
+		BatchedGoldenSection<S, S, LANES> batched(EPSILON);
+
+		std::vector<PointRegion<S>> one, plain, lanes;
+		double tOne = Milliseconds([&] {
+			one.clear();
+			for (auto const& r : regions)
+				one.push_back(scalar.minimize(func, r).value_or(r));
+		});
+		double tPlain = Milliseconds([&] { plain = batched(func, regions); });
+		double tLanes = Milliseconds([&] { lanes = batched(batch, regions); });
+
+		std::cout << name << '\t' << tOne << '\t' << tPlain << '\t' << tLanes << '\t' << tOne / tLanes << '\n';
+		return Same(one, plain) && Same(one, lanes);
+	}
+}
+
+int main()
+{
+	std::cout << std::setprecision(3);
+	std::cout << "function\tgolden section ms\tbatched ms\tbatched with batch function ms\tspeedup\n";
+
+	// intervals of helper1 width around random centers
+	std::vector<PointRegion<S>> regions;
+	std::mt19937 engine;
+	std::uniform_real_distribution<S> center(-1, 1);
+	for (std::size_t i = 0; i < INTERVALS; i++)
+		regions.push_back({center(engine), 1});
+
+	auto helper1 = [](S x) { return std::pow(x, 4) - 1.5 * std::atan(x); };
+	auto helper1Batch = [&](Batch const& xs) {
+		Batch res;
+		for (std::size_t i = 0; i < LANES; i++)
+			res[i] = helper1(xs[i]);
+		return res;
+	};
+	// cheap function, time is spent in approximator itself
+	auto poly = [](S x) { return x * x * x * x - 1.5 * x; };
+	auto polyBatch = [&](Batch const& xs) {
+		Batch res;
+		for (std::size_t i = 0; i < LANES; i++)
+			res[i] = poly(xs[i]);
+		return res;
+	};
+
+	bool ok = true;
+	ok &= Compare("helper1", helper1, helper1Batch, regions);
+	ok &= Compare("polynomial", poly, polyBatch, regions);
+
+	if (!ok)
+	{
+		std::cerr << "batched results differ from golden section" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}